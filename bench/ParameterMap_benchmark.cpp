@@ -0,0 +1,445 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AtomicParameterMap.h"
+#include "ConcurrentParameterMap.h"
+#include "ParameterMap.h"
+#include "ParameterMapHandle.h"
+
+/////////////////////////////////////////////////////////////
+//////////////////  Allocation counting  ////////////////////
+/////////////////////////////////////////////////////////////
+
+// Every replaceable allocation function is replaced, so that each allocation is counted and each deallocation frees
+// memory obtained from the matching allocation function.
+
+namespace {
+std::atomic<size_t> n_allocations{0};
+
+void *counted_malloc(size_t size) noexcept {
+	++n_allocations;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void *counted_aligned_alloc(size_t size, std::align_val_t alignment) noexcept {
+	++n_allocations;
+	const auto align = static_cast<size_t>(alignment);
+	// aligned_alloc requires the size to be a multiple of the alignment.
+	return std::aligned_alloc(align, (std::max(size, size_t{1}) + align - 1) / align * align);
+}
+
+// Not inlined, GCC would otherwise warn about the call to free in a replaced operator delete inlined next to a call of
+// operator new.
+[[gnu::noinline]] void deallocate(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void *checked(void *ptr) {
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+}  // namespace
+
+void *operator new(size_t size) {
+	return checked(counted_malloc(size));
+}
+
+void *operator new[](size_t size) {
+	return checked(counted_malloc(size));
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return counted_malloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return counted_malloc(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+	return checked(counted_aligned_alloc(size, alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+	return checked(counted_aligned_alloc(size, alignment));
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+	return counted_aligned_alloc(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+	return counted_aligned_alloc(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+	deallocate(ptr);
+}
+
+namespace {
+using qbouts::AtomicParameterMap;
+using qbouts::ConcurrentParameterMap;
+using qbouts::ParameterMap;
+using qbouts::ParameterMapHandle;
+
+/**
+ *  @brief Reports the number of allocations per iteration made since construction as the "allocs/op" counter.
+ */
+class AllocationCounter {
+public:
+	explicit AllocationCounter(benchmark::State &state) : m_state(state), m_start(n_allocations.load()) {}
+	~AllocationCounter() {
+		m_state.counters["allocs/op"] =
+				benchmark::Counter(static_cast<double>(n_allocations.load() - m_start), benchmark::Counter::kAvgIterations);
+	}
+
+private:
+	benchmark::State &m_state;
+	size_t m_start;
+};
+
+/////////////////////////////////////////////////////////////
+//////////////////    Generated maps    /////////////////////
+/////////////////////////////////////////////////////////////
+
+struct LargeStruct {
+	std::array<double, 32> values{};
+};
+
+template <typename T>
+T value_for() {
+	if constexpr (std::is_same_v<T, std::string>) {
+		return "Homer Simpson";
+	} else {
+		return T{};
+	}
+}
+
+template <size_t, typename T>
+using repeat_t = T;
+
+template <typename T, typename INDICES>
+struct GeneratedMap;
+
+/**
+ *  @brief A ParameterMap with one parameter of type T per index, named "p<index>" padded with 'x' to a name length.
+ */
+template <typename T, size_t... I>
+struct GeneratedMap<T, std::index_sequence<I...>> {
+	using type = ParameterMap<repeat_t<I, T>...>;
+	static constexpr size_t n_parameters = sizeof...(I);
+
+	static std::vector<std::string> names(size_t name_length) {
+		std::vector<std::string> ret;
+		for (size_t i = 0; i < n_parameters; ++i) {
+			std::string name = "p" + std::to_string(i);
+			name.resize(std::max(name_length, name.size()), 'x');
+			ret.push_back(std::move(name));
+		}
+		return ret;
+	}
+
+	static type make(const std::vector<std::string> &names) { return type{names[I]...}; }
+
+	static void fill(type &map) { (map.template set<I>(value_for<T>()), ...); }
+};
+
+template <typename T, size_t N>
+using generated_map = GeneratedMap<T, std::make_index_sequence<N>>;
+
+double checksum(double value) {
+	return value;
+}
+
+double checksum(const std::string &value) {
+	return static_cast<double>(value.size() + static_cast<unsigned char>(value.back()));
+}
+
+double checksum(const LargeStruct &value) {
+	return std::accumulate(value.values.begin(), value.values.end(), 0.0);
+}
+
+/**
+ *  @brief The function called by the submit benchmarks. It reads every value, so calls can not be folded to a constant.
+ */
+constexpr auto consume = [](const auto &... values) { return (0.0 + ... + checksum(values)); };
+
+/////////////////////////////////////////////////////////////
+//////////////////      Benchmarks      /////////////////////
+/////////////////////////////////////////////////////////////
+
+// All benchmarks address the last parameter, which is the worst case for lookups that scan the parameters.
+// The argument of the benchmarks which identify parameters by name is the length of the names.
+
+template <typename T, size_t N>
+void BM_SetByName(benchmark::State &state) {
+	const auto names = generated_map<T, N>::names(static_cast<size_t>(state.range(0)));
+	auto map = generated_map<T, N>::make(names);
+	const std::string &name = names.back();
+	const T value = value_for<T>();
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		map.set(name, value);
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename T, size_t N>
+void BM_SetByRuntimeIndex(benchmark::State &state) {
+	auto map = generated_map<T, N>::make(generated_map<T, N>::names(0));
+	const T value = value_for<T>();
+	size_t index = N - 1;
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index);
+		map.set(index, value);
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename T, size_t N>
+void BM_SetByCompileTimeIndex(benchmark::State &state) {
+	auto map = generated_map<T, N>::make(generated_map<T, N>::names(0));
+	const T value = value_for<T>();
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		map.template set<N - 1>(value);
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename T, size_t N>
+void BM_SetByKey(benchmark::State &state) {
+	const auto names = generated_map<T, N>::names(0);
+	auto map = generated_map<T, N>::make(names);
+	const auto key = map.key(names.back());
+	const T value = value_for<T>();
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		map.set(key, value);
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename T, size_t N>
+void BM_GetByName(benchmark::State &state) {
+	const auto names = generated_map<T, N>::names(static_cast<size_t>(state.range(0)));
+	auto map = generated_map<T, N>::make(names);
+	generated_map<T, N>::fill(map);
+	const std::string &name = names.back();
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(&map.template get<T>(name));
+	}
+}
+
+template <typename T, size_t N>
+void BM_GetByRuntimeIndex(benchmark::State &state) {
+	auto map = generated_map<T, N>::make(generated_map<T, N>::names(0));
+	generated_map<T, N>::fill(map);
+	size_t index = N - 1;
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index);
+		benchmark::DoNotOptimize(&map.template get<T>(index));
+	}
+}
+
+template <typename T, size_t N>
+void BM_IsSetByName(benchmark::State &state) {
+	const auto names = generated_map<T, N>::names(static_cast<size_t>(state.range(0)));
+	auto map = generated_map<T, N>::make(names);
+	const std::string &name = names.back();
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.is_set(name));
+	}
+}
+
+// Filling is included in the measurement, pausing the timer for it would cost more than clearing the map.
+template <typename T, size_t N>
+void BM_FillAndClear(benchmark::State &state) {
+	auto map = generated_map<T, N>::make(generated_map<T, N>::names(0));
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		generated_map<T, N>::fill(map);
+		map.clear();
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename T, size_t N>
+void BM_Submit(benchmark::State &state) {
+	auto map = generated_map<T, N>::make(generated_map<T, N>::names(0));
+	generated_map<T, N>::fill(map);
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.submit(consume));
+	}
+}
+
+template <typename T, size_t... I>
+void direct_call(benchmark::State &state, std::index_sequence<I...>) {
+	const std::array<T, sizeof...(I)> values{(static_cast<void>(I), value_for<T>())...};
+	AllocationCounter allocations(state);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(values);
+		benchmark::DoNotOptimize(consume(values[I]...));
+	}
+}
+
+template <typename T, size_t N>
+void BM_DirectCall(benchmark::State &state) {
+	direct_call<T>(state, std::make_index_sequence<N>{});
+}
+
+#define PARAMETER_MAP_BENCHMARK_NAMED(BENCHMARK, T)                                                             \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 1)->Arg(4)->Arg(16)->Arg(64);                                              \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 4)->Arg(4)->Arg(16)->Arg(64);                                              \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 16)->Arg(4)->Arg(16)->Arg(64);                                             \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 64)->Arg(4)->Arg(16)->Arg(64)
+
+#define PARAMETER_MAP_BENCHMARK(BENCHMARK, T)                                                                   \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 1);                                                                        \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 4);                                                                        \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 16);                                                                       \
+	BENCHMARK_TEMPLATE(BENCHMARK, T, 64)
+
+#define PARAMETER_MAP_BENCHMARKS(T)                                                                             \
+	PARAMETER_MAP_BENCHMARK_NAMED(BM_SetByName, T);                                                             \
+	PARAMETER_MAP_BENCHMARK(BM_SetByRuntimeIndex, T);                                                           \
+	PARAMETER_MAP_BENCHMARK(BM_SetByCompileTimeIndex, T);                                                       \
+	PARAMETER_MAP_BENCHMARK(BM_SetByKey, T);                                                                    \
+	PARAMETER_MAP_BENCHMARK_NAMED(BM_GetByName, T);                                                             \
+	PARAMETER_MAP_BENCHMARK(BM_GetByRuntimeIndex, T);                                                           \
+	PARAMETER_MAP_BENCHMARK_NAMED(BM_IsSetByName, T);                                                           \
+	PARAMETER_MAP_BENCHMARK(BM_FillAndClear, T);                                                                \
+	PARAMETER_MAP_BENCHMARK(BM_Submit, T);                                                                      \
+	PARAMETER_MAP_BENCHMARK(BM_DirectCall, T)
+
+/////////////////////////////////////////////////////////////
+//////////////////   Concurrent reads   /////////////////////
+/////////////////////////////////////////////////////////////
+
+using TuningMap = ParameterMap<double, double, double, double>;
+
+TuningMap make_tuning_map() {
+	TuningMap map{"a", "b", "c", "d"};
+	map.set<0>(1.0);
+	map.set<1>(2.0);
+	map.set<2>(3.0);
+	map.set<3>(4.0);
+	return map;
+}
+
+double sum_tuning(double a, double b, double c, double d) {
+	return a + b + c + d;
+}
+
+// Readers of a map shared through a mutex, the alternative to a ConcurrentParameterMap.
+void BM_MutexGuardedSubmit(benchmark::State &state) {
+	static const TuningMap map = make_tuning_map();
+	static std::mutex mutex;
+	for (auto _ : state) {
+		std::lock_guard<std::mutex> lock(mutex);
+		benchmark::DoNotOptimize(map.submit(sum_tuning));
+	}
+}
+
+void BM_ConcurrentSubmit(benchmark::State &state) {
+	static const ConcurrentParameterMap<TuningMap> map{make_tuning_map()};
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.submit(sum_tuning));
+	}
+}
+
+// Readers of a map shared through a ParameterMapHandle.
+void BM_HandleSubmit(benchmark::State &state) {
+	static const ParameterMapHandle<TuningMap> handle{make_tuning_map()};
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(handle.submit(sum_tuning));
+	}
+}
+
+// Readers of a map whose values are individual atomics.
+void BM_AtomicSubmit(benchmark::State &state) {
+	static const AtomicParameterMap<TuningMap> map{make_tuning_map()};
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.submit(sum_tuning));
+	}
+}
+
+BENCHMARK(BM_MutexGuardedSubmit)->ThreadRange(1, 8);
+BENCHMARK(BM_ConcurrentSubmit)->ThreadRange(1, 8);
+BENCHMARK(BM_HandleSubmit)->ThreadRange(1, 8);
+BENCHMARK(BM_AtomicSubmit)->ThreadRange(1, 8);
+
+PARAMETER_MAP_BENCHMARKS(int);
+PARAMETER_MAP_BENCHMARKS(double);
+PARAMETER_MAP_BENCHMARKS(std::string);
+PARAMETER_MAP_BENCHMARKS(LargeStruct);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+// Instantiates every member of a ParameterMap with N_PARAMETERS parameters. Used by the compile_time_benchmark target
+// to measure how the cost of instantiating a map grows with the number of parameters.
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "ParameterMap.h"
+
+#ifndef N_PARAMETERS
+#define N_PARAMETERS 8
+#endif
+
+namespace {
+template <size_t I>
+using parameter_t = std::tuple_element_t<I % 4, std::tuple<int, double, const std::string &, bool>>;
+
+template <typename INDICES>
+struct GeneratedMap;
+
+template <size_t... I>
+struct GeneratedMap<std::index_sequence<I...>> {
+	using type = qbouts::ParameterMap<parameter_t<I>...>;
+
+	static std::array<std::string, sizeof...(I)> names() { return {("p" + std::to_string(I))...}; }
+
+	static type make() {
+		static const auto generated_names = names();
+		return type{generated_names[I]...};
+	}
+
+	template <size_t INDEX>
+	static auto value() {
+		if constexpr (std::is_same_v<parameter_t<INDEX>, const std::string &>) {
+			return std::string("value");
+		} else {
+			return parameter_t<INDEX>{};
+		}
+	}
+
+	static size_t exercise(size_t runtime_index) {
+		auto map = make();
+		(map.set("p" + std::to_string(I), value<I>()), ...);
+		(map.set(I, value<I>()), ...);
+		(map.template set<I>(value<I>()), ...);
+		size_t n_set = (size_t{map.is_set(runtime_index)} + ... + size_t{map.template is_set<I>()});
+		n_set += map.template get<int>(size_t{0});
+		n_set += map.submit([](const parameter_t<I> &... values) { return sizeof...(values); });
+		map.clear();
+		return n_set;
+	}
+};
+}  // namespace
+
+int main(int argc, char **) {
+	return static_cast<int>(GeneratedMap<std::make_index_sequence<N_PARAMETERS>>::exercise(static_cast<size_t>(argc)) % 2);
+}
@@ -0,0 +1,165 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef ASYNC_SUBMIT_H
+#define ASYNC_SUBMIT_H
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define QBOUTS_HAS_COROUTINES 1
+#endif
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Submits \a map to \a function on one of the workers of \a executor.
+ *  @param map The map to submit. It is taken by value: pass std::move(map) to hand the stored values over to the
+ *    call, or a copy to keep using the map. Borrowed values must remain valid until the call has been made.
+ *  @param function The function to be called, it is copied (or moved) along with the map.
+ *  @param executor The executor running the call, e.g. a WorkStealingPool. It should provide \a execute(task).
+ *  @return A future of the return value of the call, or of the exception thrown by \a submit.
+ *
+ *  The stored values are moved into \a function, as by std::move(map).submit(function).
+ */
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+auto submit_async(MAP map, FUNCTION &&function, EXECUTOR &executor);
+
+#if defined(QBOUTS_HAS_COROUTINES)
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+class SubmitAwaitable;
+
+/**
+ *  @brief Returns an awaitable which submits \a map to \a function on one of the workers of \a executor.
+ *
+ *  The awaiting coroutine is suspended until the call has been made and is resumed on the worker which made it.
+ *  co_await yields the return value of the call or rethrows the exception thrown by \a submit. See \a submit_async for
+ *  the parameters.
+ */
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+SubmitAwaitable<MAP, std::decay_t<FUNCTION>, EXECUTOR> submit_awaitable(MAP map,
+																																				 FUNCTION &&function,
+																																				 EXECUTOR &executor);
+#endif
+
+
+/////////////////////////////////////////////////////////////
+//////////////////     submit_async     /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+template <typename MAP, typename FUNCTION>
+using async_result_t = std::decay_t<decltype(std::declval<MAP &&>().submit(std::declval<FUNCTION &>()))>;
+
+/**
+ *  @brief Makes the call of \a submit_async and stores its outcome in \a promise.
+ *
+ *  Shared by the task, as the executor may copy it.
+ */
+template <typename MAP, typename FUNCTION>
+struct AsyncSubmission {
+	AsyncSubmission(MAP &&map, FUNCTION &&function) : map(std::move(map)), function(std::move(function)) {}
+
+	MAP map;
+	FUNCTION function;
+	std::promise<async_result_t<MAP, FUNCTION>> promise;
+
+	void run() noexcept {
+		try {
+			if constexpr (std::is_void_v<async_result_t<MAP, FUNCTION>>) {
+				std::move(map).submit(function);
+				promise.set_value();
+			} else {
+				promise.set_value(std::move(map).submit(function));
+			}
+		} catch (...) {
+			promise.set_exception(std::current_exception());
+		}
+	}
+};
+}  // namespace detail
+
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+auto submit_async(MAP map, FUNCTION &&function, EXECUTOR &executor) {
+	using function_t = std::decay_t<FUNCTION>;
+	auto submission = std::make_shared<detail::AsyncSubmission<MAP, function_t>>(
+			std::move(map), function_t(std::forward<FUNCTION>(function)));
+	auto future = submission->promise.get_future();
+	executor.execute([submission] { submission->run(); });
+	return future;
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   SubmitAwaitable    /////////////////////
+/////////////////////////////////////////////////////////////
+
+#if defined(QBOUTS_HAS_COROUTINES)
+/**
+ *  @brief The awaitable returned by \a submit_awaitable.
+ */
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+class SubmitAwaitable {
+public:
+	using result_type = detail::async_result_t<MAP, FUNCTION>;
+
+	SubmitAwaitable(MAP map, FUNCTION function, EXECUTOR &executor)
+			: m_map(std::move(map)), m_function(std::move(function)), m_executor(executor) {}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> awaiting) {
+		// The awaitable lives in the frame of the suspended coroutine until it is resumed by the task.
+		m_executor.execute([this, awaiting] {
+			try {
+				if constexpr (std::is_void_v<result_type>) {
+					std::move(m_map).submit(m_function);
+				} else {
+					m_result.emplace(std::move(m_map).submit(m_function));
+				}
+			} catch (...) {
+				m_exception = std::current_exception();
+			}
+			awaiting.resume();
+		});
+	}
+
+	result_type await_resume() {
+		if (m_exception) {
+			std::rethrow_exception(m_exception);
+		}
+		if constexpr (!std::is_void_v<result_type>) {
+			return std::move(*m_result);
+		}
+	}
+
+private:
+	MAP m_map;
+	FUNCTION m_function;
+	EXECUTOR &m_executor;
+	std::optional<std::conditional_t<std::is_void_v<result_type>, bool, result_type>> m_result;
+	std::exception_ptr m_exception;
+};
+
+template <typename MAP, typename FUNCTION, typename EXECUTOR>
+SubmitAwaitable<MAP, std::decay_t<FUNCTION>, EXECUTOR> submit_awaitable(MAP map,
+																																				 FUNCTION &&function,
+																																				 EXECUTOR &executor) {
+	return {std::move(map), std::decay_t<FUNCTION>(std::forward<FUNCTION>(function)), executor};
+}
+#endif
+
+}  // namespace qbouts
+
+#endif
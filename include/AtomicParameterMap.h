@@ -0,0 +1,259 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef ATOMIC_PARAMETER_MAP_H
+#define ATOMIC_PARAMETER_MAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+namespace detail {
+template <typename MAP, typename SEQUENCE>
+struct AtomicValues;
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////
+//////////////////  AtomicParameterMap  /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief A parameter map whose values are set and read with single lock-free atomic operations.
+ *  @tparam MAP The map type providing the names and parameter types, e.g. ParameterMap<int, double, bool>. It should
+ *    have at most 64 parameters, all of them trivially copyable types whose std::atomic is always lock-free, such as
+ *    integers, floating point numbers, bools and enums.
+ *
+ *  Every value is stored in a std::atomic of its own and the presence of all values in a single atomic word. \a set
+ *  stores the value and then marks it present with release semantics, \a get checks its presence and loads the value
+ *  with acquire semantics, so a value is visible to other threads as soon as \a set returns. Neither takes a lock.
+ *
+ *  Values are independent: \a submit and \a snapshot load them one at a time and may combine values of different
+ *  \a set calls. Use ConcurrentParameterMap to publish several values together.
+ */
+template <typename MAP>
+class AtomicParameterMap {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param map The names and initial values of the parameters.
+	 */
+	explicit AtomicParameterMap(const MAP &map);
+
+	AtomicParameterMap(const AtomicParameterMap &) = delete;
+	AtomicParameterMap &operator=(const AtomicParameterMap &) = delete;
+
+	/****************************************************************************/
+	/********************************* Writers **********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a name.
+	 *  @throw  std::invalid_argument if no parameters match @a name or the parameter type is incompatible to @a value.
+	 */
+	template <typename T>
+	void set(const std::string_view &name, T &&value);
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a INDEX.
+	 *
+	 *  \a value is converted to the parameter type before it is stored, narrowing as ParameterMap::set does.
+	 */
+	template <size_t INDEX, typename T>
+	void set(T &&value) noexcept requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Removes the value of the parameter identified by \a INDEX.
+	 */
+	template <size_t INDEX>
+	void reset() noexcept requires(INDEX < MAP::size());
+
+	/****************************************************************************/
+	/********************************* Readers **********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Returns the value of the parameter identified by \a INDEX.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] auto get() const requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Returns the value of the parameter identified by \a name.
+	 *  @throw  std::invalid_argument if no parameters match @a name or if the parameter type is incompatible to @a T.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] std::remove_cv_t<std::remove_reference_t<T>> get(const std::string_view &name) const;
+
+	/**
+	 *  @brief Returns whether a value is stored for the parameter identified by \a INDEX.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] bool is_set() const noexcept requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Calls \a function with the current values, loaded one at a time.
+	 *  @return The return value of the call.
+	 *  @throw  std::runtime_error if not all parameters have values stored.
+	 */
+	template <typename FUNCTION>
+	auto submit(FUNCTION &&function) const;
+
+	/**
+	 *  @brief Returns a copy of the map holding the current values, loaded one at a time.
+	 */
+	[[nodiscard]] MAP snapshot() const;
+
+	static constexpr size_t size() noexcept { return MAP::size(); }
+
+private:
+	static constexpr size_t n_parameters = MAP::size();
+
+	template <size_t INDEX>
+	using value_t = std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<INDEX>>>;
+
+	template <size_t INDEX>
+	static constexpr std::uint64_t presence_bit = std::uint64_t{1} << INDEX;
+
+	const MAP m_names;  // Never modified, used to look up names and as the base of snapshots.
+	std::atomic<std::uint64_t> m_presence{0};
+	typename detail::AtomicValues<MAP, std::make_index_sequence<MAP::size()>>::type m_values;
+
+	template <typename FUNCTION, size_t... I>
+	auto submit(FUNCTION &&function, std::index_sequence<I...>) const;
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////  AtomicParameterMap  /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+template <typename MAP, size_t... I>
+struct AtomicValues<MAP, std::index_sequence<I...>> {
+	using type =
+			std::tuple<std::atomic<std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<I>>>>...>;
+};
+}  // namespace detail
+
+template <typename MAP>
+AtomicParameterMap<MAP>::AtomicParameterMap(const MAP &map) : m_names(map) {
+	static_assert(n_parameters <= 64, "An AtomicParameterMap has at most 64 parameters");
+	detail::static_for<0, n_parameters>([&](auto i) {
+		static_assert(std::is_trivially_copyable_v<value_t<i.value>> && !detail::is_borrowed_v<value_t<i.value>> &&
+											std::atomic<value_t<i.value>>::is_always_lock_free,
+									"The parameters of an AtomicParameterMap should be lock-free atomic types");
+		if (map.template is_set<i.value>()) {
+			set<i.value>(map.template get<i.value>());
+		}
+	});
+}
+
+template <typename MAP>
+template <typename T>
+void AtomicParameterMap<MAP>::set(const std::string_view &name, T &&value) {
+	detail::visit_index<n_parameters>(m_names.key(name).index(), [&](auto i) {
+		if constexpr (std::is_convertible_v<std::remove_cv_t<std::remove_reference_t<T>>, value_t<i.value>>) {
+			set<i.value>(std::forward<T>(value));
+		} else {
+			throw std::invalid_argument("Parameter type is incompatible");
+		}
+	});
+}
+
+template <typename MAP>
+template <size_t INDEX, typename T>
+void AtomicParameterMap<MAP>::set(T &&value) noexcept requires(INDEX < MAP::size()) {
+	const value_t<INDEX> converted = std::forward<T>(value);
+	std::get<INDEX>(m_values).store(converted, std::memory_order_release);
+	// The release keeps the value ordered before its presence bit: a reader observing the bit observes the value.
+	if (!(m_presence.load(std::memory_order_relaxed) & presence_bit<INDEX>)) {
+		m_presence.fetch_or(presence_bit<INDEX>, std::memory_order_release);
+	}
+}
+
+template <typename MAP>
+template <size_t INDEX>
+void AtomicParameterMap<MAP>::reset() noexcept requires(INDEX < MAP::size()) {
+	m_presence.fetch_and(~presence_bit<INDEX>, std::memory_order_release);
+}
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] auto AtomicParameterMap<MAP>::get() const requires(INDEX < MAP::size()) {
+	if (!is_set<INDEX>()) {
+		throw std::runtime_error("Parameter does not have a stored value");
+	}
+	return std::get<INDEX>(m_values).load(std::memory_order_acquire);
+}
+
+template <typename MAP>
+template <typename T>
+[[nodiscard]] std::remove_cv_t<std::remove_reference_t<T>> AtomicParameterMap<MAP>::get(
+		const std::string_view &name) const {
+	using result_t = std::remove_cv_t<std::remove_reference_t<T>>;
+	std::optional<result_t> result;
+	detail::visit_index<n_parameters>(m_names.key(name).index(), [&](auto i) {
+		if constexpr (std::is_same_v<value_t<i.value>, result_t>) {
+			result.emplace(get<i.value>());
+		} else {
+			throw std::invalid_argument("Parameter type is incompatible");
+		}
+	});
+	return *result;
+}
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] bool AtomicParameterMap<MAP>::is_set() const noexcept requires(INDEX < MAP::size()) {
+	return m_presence.load(std::memory_order_acquire) & presence_bit<INDEX>;
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+auto AtomicParameterMap<MAP>::submit(FUNCTION &&function) const {
+	constexpr std::uint64_t all_present = n_parameters == 0 ? 0 : ~std::uint64_t{0} >> (64 - n_parameters);
+	if ((m_presence.load(std::memory_order_acquire) & all_present) != all_present) {
+		throw std::runtime_error("Not all parameters have values stored");
+	}
+	return submit(std::forward<FUNCTION>(function), std::make_index_sequence<n_parameters>{});
+}
+
+template <typename MAP>
+[[nodiscard]] MAP AtomicParameterMap<MAP>::snapshot() const {
+	const std::uint64_t presence = m_presence.load(std::memory_order_acquire);
+	MAP map = m_names;
+	map.clear();
+	detail::static_for<0, n_parameters>([&](auto i) {
+		if (presence & presence_bit<i.value>) {
+			map.template set<i.value>(std::get<i.value>(m_values).load(std::memory_order_acquire));
+		}
+	});
+	return map;
+}
+
+////////////////////// Private Members //////////////////////
+
+template <typename MAP>
+template <typename FUNCTION, size_t... I>
+auto AtomicParameterMap<MAP>::submit(FUNCTION &&function, std::index_sequence<I...>) const {
+	return std::invoke(std::forward<FUNCTION>(function), std::get<I>(m_values).load(std::memory_order_acquire)...);
+}
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,350 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef CONCURRENT_PARAMETER_MAP_H
+#define CONCURRENT_PARAMETER_MAP_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/////////////////////////////////////////////////////////////
+////////////////// ConcurrentParameterMap ///////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief A parameter map which may be read by any number of threads while other threads set its values.
+ *  @tparam MAP The map type being shared, e.g. ParameterMap<int, double>. All of its parameters should be trivially
+ *    copyable and should not be Borrowed.
+ *
+ *  The values are published using a sequence lock: writers are serialized by a mutex and increment a sequence number
+ *  before and after they store the values, readers copy the values and retry if the sequence number was odd or
+ *  changed in the meantime. Readers therefore never take a lock or write to shared memory, so they do not contend
+ *  with each other, and always observe a consistent snapshot: all values published by a single \a set or \a update
+ *  call, or none of them. A reader only retries if a write overlaps its copy.
+ *
+ *  Values are copied out of the map rather than referenced: \a get returns a copy and \a submit passes copies of the
+ *  values to the function, which may therefore run while the values are being changed.
+ */
+template <typename MAP>
+class ConcurrentParameterMap {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param map The names and initial values of the parameters.
+	 */
+	explicit ConcurrentParameterMap(MAP map);
+
+	ConcurrentParameterMap(const ConcurrentParameterMap &) = delete;
+	ConcurrentParameterMap &operator=(const ConcurrentParameterMap &) = delete;
+
+	/****************************************************************************/
+	/********************************* Writers **********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Sets and publishes the value of the parameter identified by \a name.
+	 *  @throw  std::invalid_argument if no parameters match @a name or the parameter type is incompatible to @a value.
+	 */
+	template <typename T>
+	void set(const std::string_view &name, T &&value);
+
+	/**
+	 *  @brief Sets and publishes the value of the parameter identified by \a INDEX.
+	 */
+	template <size_t INDEX, typename T>
+	void set(T &&value);
+
+	/**
+	 *  @brief Calls \a function with a copy of the current map and publishes the modified copy as a whole.
+	 *
+	 *  Use this to change several values at once: readers observe either all of the changes or none of them. Nothing is
+	 *  published if \a function throws.
+	 */
+	template <typename FUNCTION>
+	void update(FUNCTION &&function) requires(std::is_invocable_v<FUNCTION, MAP &>);
+
+	/****************************************************************************/
+	/********************************* Readers **********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Returns a copy of the value of the parameter identified by \a INDEX.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] auto get() const requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Returns a copy of the value of the parameter identified by \a name.
+	 *  @throw  std::invalid_argument if no parameters match @a name or if the parameter type is incompatible to @a T.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] std::remove_cv_t<std::remove_reference_t<T>> get(const std::string_view &name) const;
+
+	/**
+	 *  @brief Returns whether a value is stored for the parameter identified by \a INDEX.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] bool is_set() const noexcept requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Calls \a function with a consistent snapshot of the values.
+	 *  @return The return value of the call.
+	 *  @throw  std::runtime_error if not all parameters have values stored.
+	 */
+	template <typename FUNCTION>
+	auto submit(FUNCTION &&function) const;
+
+	/**
+	 *  @brief Returns a copy of the map holding a consistent snapshot of the values.
+	 */
+	[[nodiscard]] MAP snapshot() const;
+
+	static constexpr size_t size() noexcept { return MAP::size(); }
+
+private:
+	static constexpr size_t n_parameters = MAP::size();
+
+	template <size_t INDEX>
+	using value_t = std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<INDEX>>>;
+
+	struct Layout;
+	using words_t = std::array<std::uint64_t, Layout::n_words>;
+
+	const MAP m_names;  // Never modified, used by readers to look up names and as the base of snapshots.
+	MAP m_current;      // The last published map, only accessed by writers.
+	std::mutex m_write_mutex;
+
+	alignas(64) std::atomic<std::uint64_t> m_sequence{0};
+	std::array<std::atomic<std::uint64_t>, Layout::n_words> m_words{};
+
+	void publish();
+
+	void load(words_t &words, size_t first, size_t last, size_t presence_word) const noexcept;
+
+	static bool is_present(const words_t &words, size_t index) noexcept;
+
+	template <size_t INDEX>
+	static value_t<INDEX> decode(const words_t &words) noexcept;
+
+	template <typename FUNCTION, size_t... I>
+	static auto submit(const words_t &words, FUNCTION &&function, std::index_sequence<I...>);
+};
+
+
+/////////////////////////////////////////////////////////////
+////////////////// ConcurrentParameterMap ///////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  The values are stored as 64 bit words: first the presence bits, then the bytes of the values, packed in order.
+ */
+template <typename MAP>
+struct ConcurrentParameterMap<MAP>::Layout {
+	template <size_t... I>
+	static constexpr std::array<size_t, n_parameters + 1> compute_offsets(std::index_sequence<I...>) {
+		std::array<size_t, n_parameters + 1> offsets{};
+		size_t offset = n_presence_words * sizeof(std::uint64_t);
+		size_t i = 0;
+		((offsets[i++] = offset, offset += sizeof(value_t<I>)), ...);
+		offsets[n_parameters] = offset;
+		return offsets;
+	}
+
+	static constexpr size_t n_presence_words = (n_parameters + 63) / 64;
+	static constexpr auto offsets = compute_offsets(std::make_index_sequence<n_parameters>{});
+	static constexpr size_t n_words = (offsets[n_parameters] + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+};
+
+template <typename MAP>
+ConcurrentParameterMap<MAP>::ConcurrentParameterMap(MAP map) : m_names(map), m_current(std::move(map)) {
+	detail::static_for<0, n_parameters>([](auto i) {
+		static_assert(std::is_trivially_copyable_v<value_t<i.value>> && !detail::is_borrowed_v<value_t<i.value>>,
+									"The parameters of a ConcurrentParameterMap should be trivially copyable");
+	});
+	publish();
+}
+
+template <typename MAP>
+template <typename T>
+void ConcurrentParameterMap<MAP>::set(const std::string_view &name, T &&value) {
+	std::lock_guard<std::mutex> lock(m_write_mutex);
+	m_current.set(name, std::forward<T>(value));
+	publish();
+}
+
+template <typename MAP>
+template <size_t INDEX, typename T>
+void ConcurrentParameterMap<MAP>::set(T &&value) {
+	std::lock_guard<std::mutex> lock(m_write_mutex);
+	m_current.template set<INDEX>(std::forward<T>(value));
+	publish();
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+void ConcurrentParameterMap<MAP>::update(FUNCTION &&function) requires(std::is_invocable_v<FUNCTION, MAP &>) {
+	std::lock_guard<std::mutex> lock(m_write_mutex);
+	MAP next = m_current;
+	std::invoke(std::forward<FUNCTION>(function), next);
+	m_current = std::move(next);
+	publish();
+}
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] auto ConcurrentParameterMap<MAP>::get() const requires(INDEX < MAP::size()) {
+	words_t words;
+	load(words,
+			 Layout::offsets[INDEX] / sizeof(std::uint64_t),
+			 (Layout::offsets[INDEX + 1] + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t),
+			 INDEX / 64);
+	if (!is_present(words, INDEX)) {
+		throw std::runtime_error("Parameter does not have a stored value");
+	}
+	return decode<INDEX>(words);
+}
+
+template <typename MAP>
+template <typename T>
+[[nodiscard]] std::remove_cv_t<std::remove_reference_t<T>> ConcurrentParameterMap<MAP>::get(
+		const std::string_view &name) const {
+	using result_t = std::remove_cv_t<std::remove_reference_t<T>>;
+	std::optional<result_t> result;
+	detail::visit_index<n_parameters>(m_names.key(name).index(), [&](auto i) {
+		if constexpr (std::is_same_v<value_t<i.value>, result_t>) {
+			result.emplace(get<i.value>());
+		} else {
+			throw std::invalid_argument("Parameter type is incompatible");
+		}
+	});
+	return *result;
+}
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] bool ConcurrentParameterMap<MAP>::is_set() const noexcept requires(INDEX < MAP::size()) {
+	words_t words;
+	load(words, 0, 0, INDEX / 64);
+	return is_present(words, INDEX);
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+auto ConcurrentParameterMap<MAP>::submit(FUNCTION &&function) const {
+	words_t words;
+	load(words, 0, Layout::n_words, 0);
+	for (size_t i = 0; i < n_parameters; ++i) {
+		if (!is_present(words, i)) {
+			throw std::runtime_error("Not all parameters have values stored");
+		}
+	}
+	return submit(words, std::forward<FUNCTION>(function), std::make_index_sequence<n_parameters>{});
+}
+
+template <typename MAP>
+[[nodiscard]] MAP ConcurrentParameterMap<MAP>::snapshot() const {
+	words_t words;
+	load(words, 0, Layout::n_words, 0);
+	MAP map = m_names;
+	map.clear();
+	detail::static_for<0, n_parameters>([&](auto i) {
+		if (is_present(words, i.value)) {
+			map.template set<i.value>(decode<i.value>(words));
+		}
+	});
+	return map;
+}
+
+////////////////////// Private Members //////////////////////
+
+/**
+ *  Stores the values of m_current, while holding m_write_mutex.
+ */
+template <typename MAP>
+void ConcurrentParameterMap<MAP>::publish() {
+	words_t words{};
+	auto *bytes = reinterpret_cast<unsigned char *>(words.data());
+	detail::static_for<0, n_parameters>([&](auto i) {
+		if (m_current.template is_set<i.value>()) {
+			words[i.value / 64] |= std::uint64_t{1} << (i.value % 64);
+			const value_t<i.value> &value = m_current.template get<i.value>();
+			std::memcpy(bytes + Layout::offsets[i.value], &value, sizeof(value));
+		}
+	});
+
+	const std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+	m_sequence.store(sequence + 1, std::memory_order_relaxed);
+	// Release stores keep the odd sequence number ordered before the words (and are plain stores on x86).
+	for (size_t i = 0; i < Layout::n_words; ++i) {
+		m_words[i].store(words[i], std::memory_order_release);
+	}
+	m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ *  Copies the words [first, last) and the presence word \a presence_word of a single published version into \a words.
+ */
+template <typename MAP>
+void ConcurrentParameterMap<MAP>::load(words_t &words, size_t first, size_t last, size_t presence_word) const
+		noexcept {
+	while (true) {
+		const std::uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+		if (sequence % 2 == 0) {
+			// A reader which observes a word of a newer version also observes its odd sequence number below.
+			words[presence_word] = m_words[presence_word].load(std::memory_order_acquire);
+			for (size_t i = first; i < last; ++i) {
+				words[i] = m_words[i].load(std::memory_order_acquire);
+			}
+			if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+				return;
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+template <typename MAP>
+bool ConcurrentParameterMap<MAP>::is_present(const words_t &words, size_t index) noexcept {
+	return (words[index / 64] >> (index % 64)) & 1;
+}
+
+template <typename MAP>
+template <size_t INDEX>
+typename ConcurrentParameterMap<MAP>::template value_t<INDEX> ConcurrentParameterMap<MAP>::decode(
+		const words_t &words) noexcept {
+	std::aligned_storage_t<sizeof(value_t<INDEX>), alignof(value_t<INDEX>)> value;
+	std::memcpy(&value,
+							reinterpret_cast<const unsigned char *>(words.data()) + Layout::offsets[INDEX],
+							sizeof(value_t<INDEX>));
+	return *std::launder(reinterpret_cast<const value_t<INDEX> *>(&value));
+}
+
+template <typename MAP>
+template <typename FUNCTION, size_t... I>
+auto ConcurrentParameterMap<MAP>::submit(const words_t &words, FUNCTION &&function, std::index_sequence<I...>) {
+	return std::invoke(std::forward<FUNCTION>(function), decode<I>(words)...);
+}
+
+}  // namespace qbouts
+
+#endif
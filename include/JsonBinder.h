@@ -0,0 +1,386 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef JSON_BINDER_H
+#define JSON_BINDER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ParameterBinding.h"
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Sets a parameter of \a map for every member of the JSON object in \a json, e.g. {"size_percent": 56.5}.
+ *  @param json A single JSON object, the member names identify the parameters.
+ *  @param map The map in which the values are stored.
+ *  @param policy What to do with members which do not match any parameter.
+ *  @return The number of parameters set, or the error which stopped binding:
+ *    - ParameterError::malformed_input if \a json is not a well-formed object,
+ *    - ParameterError::incompatible_type if the JSON type of a value does not match its parameter, e.g. a string for a
+ *      double parameter,
+ *    - ParameterError::invalid_value if a value does not fit its parameter, e.g. 1.5 for an int parameter or an escaped
+ *      string for a std::string_view parameter,
+ *    - ParameterError::unknown_name if a member does not match any parameter and \a policy is reject.
+ *
+ *  Values are converted directly from the buffer into their parameter without building a document: numbers using
+ *  std::from_chars, true and false for bool parameters, and strings for std::string or std::string_view parameters
+ *  (which refer to the buffer). Members whose value is null are skipped. Errors are reported without throwing, in
+ *  which case the parameters bound before the error remain set.
+ *
+ *  Strings and nested values of unknown members are scanned 16 bytes at a time if SSE2 is available. Nested values are
+ *  only checked for balanced brackets.
+ */
+template <typename MAP>
+Expected<size_t> bind_json(std::string_view json,
+													 MAP &map,
+													 UnknownParameterPolicy policy = UnknownParameterPolicy::ignore);
+
+
+/////////////////////////////////////////////////////////////
+//////////////////      bind_json       /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief Returns the first character in [first, last) which is one of \a CHARS, or \a last.
+ */
+template <char... CHARS>
+inline const char *find_any_of(const char *first, const char *last) noexcept {
+#if defined(__SSE2__)
+	for (; last - first >= 16; first += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+		const __m128i matches = (_mm_cmpeq_epi8(chunk, _mm_set1_epi8(CHARS)) | ...);
+		if (const int mask = _mm_movemask_epi8(matches); mask != 0) {
+			return first + count_trailing_zeros(static_cast<std::uint64_t>(mask));
+		}
+	}
+#endif
+	for (; first != last; ++first) {
+		if (((*first == CHARS) || ...)) {
+			return first;
+		}
+	}
+	return last;
+}
+
+/**
+ *  @brief Text format of JSON strings: backslash escapes, including UTF-16 \u escapes.
+ *
+ *  Strings are validated while they are read, so unescaping does not fail.
+ */
+struct JsonText {
+	static bool is_escaped(std::string_view text) noexcept { return text.find('\\') != std::string_view::npos; }
+
+	static void unescape(std::string_view text, std::string &out) {
+		for (size_t i = 0; i < text.size(); ++i) {
+			if (text[i] != '\\') {
+				out.push_back(text[i]);
+				continue;
+			}
+			switch (text[++i]) {
+				case 'b': out.push_back('\b'); break;
+				case 'f': out.push_back('\f'); break;
+				case 'n': out.push_back('\n'); break;
+				case 'r': out.push_back('\r'); break;
+				case 't': out.push_back('\t'); break;
+				case 'u': {
+					std::uint32_t code_point = hex_value(text.substr(i + 1, 4));
+					i += 4;
+					if (code_point >= 0xD800 && code_point < 0xDC00 && text.substr(i + 1, 2) == "\\u") {
+						const std::uint32_t low = hex_value(text.substr(i + 3, 4));
+						if (low >= 0xDC00 && low < 0xE000) {
+							code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+							i += 6;
+						}
+					}
+					append_utf8(code_point, out);
+					break;
+				}
+				default: out.push_back(text[i]); break;
+			}
+		}
+	}
+
+	static std::uint32_t hex_value(std::string_view digits) noexcept {
+		std::uint32_t value = 0;
+		std::from_chars(digits.data(), digits.data() + digits.size(), value, 16);
+		return value;
+	}
+};
+
+enum class JsonKind : std::uint8_t { string, number, boolean, null, container };
+
+/**
+ *  @brief Reads the tokens of a JSON buffer, reporting malformed input by returning false.
+ */
+class JsonReader {
+public:
+	explicit JsonReader(std::string_view json) noexcept : m_position(json.data()), m_end(json.data() + json.size()) {}
+
+	/**
+	 *  @brief Skips whitespace and consumes \a c if it is the next character.
+	 */
+	bool consume(char c) noexcept {
+		skip_whitespace();
+		if (m_position != m_end && *m_position == c) {
+			++m_position;
+			return true;
+		}
+		return false;
+	}
+
+	bool at_end() noexcept {
+		skip_whitespace();
+		return m_position == m_end;
+	}
+
+	/**
+	 *  @brief Reads a string, \a raw is set to its characters between the quotes, escapes included.
+	 */
+	bool read_string(std::string_view &raw) noexcept {
+		if (!consume('"')) {
+			return false;
+		}
+		const char *begin = m_position;
+		while (true) {
+			m_position = find_any_of<'"', '\\'>(m_position, m_end);
+			if (m_position == m_end) {
+				return false;
+			}
+			if (*m_position == '"') {
+				raw = std::string_view(begin, static_cast<size_t>(m_position - begin));
+				++m_position;
+				return true;
+			}
+			if (!skip_escape()) {
+				return false;
+			}
+		}
+	}
+
+	/**
+	 *  @brief Reads a value, \a raw is set to its text (for strings the characters between the quotes).
+	 */
+	bool read_value(JsonKind &kind, std::string_view &raw) noexcept {
+		skip_whitespace();
+		if (m_position == m_end) {
+			return false;
+		}
+		switch (*m_position) {
+			case '"': kind = JsonKind::string; return read_string(raw);
+			case '{':
+			case '[': kind = JsonKind::container; return skip_container(raw);
+			case 't': kind = JsonKind::boolean; return read_literal("true", raw);
+			case 'f': kind = JsonKind::boolean; return read_literal("false", raw);
+			case 'n': kind = JsonKind::null; return read_literal("null", raw);
+			default: kind = JsonKind::number; return read_number(raw);
+		}
+	}
+
+private:
+	const char *m_position;
+	const char *m_end;
+
+	void skip_whitespace() noexcept {
+		while (m_position != m_end &&
+					 (*m_position == ' ' || *m_position == '\t' || *m_position == '\n' || *m_position == '\r')) {
+			++m_position;
+		}
+	}
+
+	bool skip_escape() noexcept {
+		if (m_end - m_position < 2) {
+			return false;
+		}
+		const char escaped = m_position[1];
+		m_position += 2;
+		if (escaped == 'u') {
+			if (m_end - m_position < 4) {
+				return false;
+			}
+			for (int i = 0; i < 4; ++i, ++m_position) {
+				const char c = *m_position;
+				if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
+					return false;
+				}
+			}
+			return true;
+		}
+		return std::string_view("\"\\/bfnrt").find(escaped) != std::string_view::npos;
+	}
+
+	bool skip_container(std::string_view &raw) noexcept {
+		const char *begin = m_position;
+		size_t depth = 0;
+		while (true) {
+			m_position = find_any_of<'"', '{', '}', '[', ']'>(m_position, m_end);
+			if (m_position == m_end) {
+				return false;
+			}
+			if (*m_position == '"') {
+				std::string_view ignored;
+				if (!read_string(ignored)) {
+					return false;
+				}
+				continue;
+			}
+			const bool opens = *m_position == '{' || *m_position == '[';
+			++m_position;
+			if (opens) {
+				++depth;
+			} else if (--depth == 0) {
+				raw = std::string_view(begin, static_cast<size_t>(m_position - begin));
+				return true;
+			}
+		}
+	}
+
+	bool read_literal(std::string_view literal, std::string_view &raw) noexcept {
+		if (static_cast<size_t>(m_end - m_position) < literal.size() ||
+				std::string_view(m_position, literal.size()) != literal) {
+			return false;
+		}
+		raw = std::string_view(m_position, literal.size());
+		m_position += literal.size();
+		return true;
+	}
+
+	/**
+	 *  @brief Reads a number, which should match -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+	 */
+	bool read_number(std::string_view &raw) noexcept {
+		const char *begin = m_position;
+		skip('-');
+		if (!skip('0') && !skip_digits()) {
+			return false;
+		}
+		if (skip('.') && !skip_digits()) {
+			return false;
+		}
+		if (skip('e') || skip('E')) {
+			if (!skip('+')) {
+				skip('-');
+			}
+			if (!skip_digits()) {
+				return false;
+			}
+		}
+		raw = std::string_view(begin, static_cast<size_t>(m_position - begin));
+		return true;
+	}
+
+	bool skip(char c) noexcept {
+		if (m_position == m_end || *m_position != c) {
+			return false;
+		}
+		++m_position;
+		return true;
+	}
+
+	/**
+	 *  @brief Skips one or more digits, returns false if there are none.
+	 */
+	bool skip_digits() noexcept {
+		const char *begin = m_position;
+		while (m_position != m_end && *m_position >= '0' && *m_position <= '9') {
+			++m_position;
+		}
+		return m_position != begin;
+	}
+};
+
+/**
+ *  @brief Returns whether a JSON value of \a kind can be stored in a parameter of type \a T.
+ */
+template <typename T>
+constexpr bool is_json_kind_of(JsonKind kind) noexcept {
+	if constexpr (std::is_same_v<T, bool>) {
+		return kind == JsonKind::boolean;
+	} else if constexpr (std::is_arithmetic_v<T>) {
+		return kind == JsonKind::number;
+	} else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+		return kind == JsonKind::string;
+	} else {
+		return false;
+	}
+}
+
+template <typename MAP>
+Expected<void> bind_json_value(MAP &map, size_t index, JsonKind kind, std::string_view raw) {
+	Expected<void> result;
+	visit_index<MAP::size()>(index, [&](auto i) {
+		using value_t = std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<i.value>>>;
+		if (!is_json_kind_of<value_t>(kind)) {
+			result = ParameterError::incompatible_type;
+		} else if (auto value = try_parse_value<JsonText, value_t>(raw)) {
+			map.template set<i.value>(std::move(*value));
+		} else {
+			result = ParameterError::invalid_value;
+		}
+	});
+	return result;
+}
+}  // namespace detail
+
+template <typename MAP>
+Expected<size_t> bind_json(std::string_view json, MAP &map, UnknownParameterPolicy policy) {
+	detail::JsonReader reader(json);
+	if (!reader.consume('{')) {
+		return ParameterError::malformed_input;
+	}
+	size_t n_bound = 0;
+	if (!reader.consume('}')) {
+		std::string unescaped_name;
+		do {
+			std::string_view name;
+			detail::JsonKind kind;
+			std::string_view raw;
+			if (!reader.read_string(name) || !reader.consume(':') || !reader.read_value(kind, raw)) {
+				return ParameterError::malformed_input;
+			}
+			if (detail::JsonText::is_escaped(name)) {
+				unescaped_name.clear();
+				detail::JsonText::unescape(name, unescaped_name);
+				name = unescaped_name;
+			}
+			const auto key = map.try_key(name);
+			if (!key) {
+				if (policy == UnknownParameterPolicy::reject) {
+					return ParameterError::unknown_name;
+				}
+				continue;
+			}
+			if (kind == detail::JsonKind::null) {
+				continue;
+			}
+			if (const auto bound = detail::bind_json_value(map, key->index(), kind, raw); !bound) {
+				return bound.error();
+			}
+			++n_bound;
+		} while (reader.consume(','));
+		if (!reader.consume('}')) {
+			return ParameterError::malformed_input;
+		}
+	}
+	if (!reader.at_end()) {
+		return ParameterError::malformed_input;
+	}
+	return n_bound;
+}
+
+}  // namespace qbouts
+
+#endif
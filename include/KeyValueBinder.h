@@ -0,0 +1,154 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef KEY_VALUE_BINDER_H
+#define KEY_VALUE_BINDER_H
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ParameterBinding.h"
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Sets a parameter of \a map for every option in the command line arguments \a argv.
+ *  @param argc The number of arguments, as passed to main.
+ *  @param argv The arguments, as passed to main. argv[0] (the program name) is skipped.
+ *  @param map The map in which the values are stored.
+ *  @param policy What to do with options which do not match any parameter.
+ *  @return The number of parameters set.
+ *  @throw std::invalid_argument if a value can not be parsed into its parameter, if an argument is not an option, or
+ *    (depending on \a policy) if an option does not match any parameter.
+ *
+ *  Options are written as --name value or --name=value. A bool option may be given without a value, e.g. --flip,
+ *  which sets it to true. Values are converted in place, std::string_view parameters refer to \a argv itself so
+ *  binding allocates nothing unless the map stores a std::string. The value of an ignored option is skipped as well,
+ *  unless it is the next option.
+ */
+template <typename MAP>
+size_t bind_args(int argc,
+								 const char *const *argv,
+								 MAP &map,
+								 UnknownParameterPolicy policy = UnknownParameterPolicy::ignore);
+
+/**
+ *  @brief Sets a parameter of \a map for every name = value line of the INI text \a ini within \a section.
+ *  @param ini The lines, separated by '\n' (a trailing '\r' is ignored).
+ *  @param map The map in which the values are stored.
+ *  @param section The section from which entries are bound. The default binds the entries before the first
+ *    [section] header, which also makes plain name=value files bindable.
+ *  @param policy What to do with entries in \a section which do not match any parameter.
+ *  @return The number of parameters set.
+ *  @throw std::invalid_argument if a value can not be parsed into its parameter, or (depending on \a policy) if an
+ *    entry does not match any parameter.
+ *  @throw std::runtime_error if a line of \a section is not an entry, or a section header is not terminated.
+ *
+ *  Blank lines and lines starting with ';' or '#' are skipped. Names and values are trimmed, a value between double
+ *  quotes keeps its surrounding whitespace. Values are not unescaped, std::string_view parameters refer to \a ini.
+ */
+template <typename MAP>
+size_t bind_ini(std::string_view ini,
+								MAP &map,
+								std::string_view section = {},
+								UnknownParameterPolicy policy = UnknownParameterPolicy::ignore);
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   Key value binders  /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief Text format of command lines and INI files, which have no escapes.
+ */
+struct PlainText {
+	static constexpr bool is_escaped(std::string_view) noexcept { return false; }
+	static void unescape(std::string_view text, std::string &out) { out.append(text); }
+};
+
+template <typename MAP>
+bool is_flag(size_t index) {
+	bool flag = false;
+	visit_index<MAP::size()>(index, [&](auto i) {
+		flag = std::is_same_v<std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<i.value>>>,
+													bool>;
+	});
+	return flag;
+}
+}  // namespace detail
+
+template <typename MAP>
+size_t bind_args(int argc, const char *const *argv, MAP &map, UnknownParameterPolicy policy) {
+	size_t n_bound = 0;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view option = argv[i];
+		if (option.substr(0, 2) != "--" || option.size() == 2) {
+			throw std::invalid_argument("Unexpected argument \"" + std::string(option) + "\"");
+		}
+		option.remove_prefix(2);
+
+		const size_t equals = option.find('=');
+		const std::string_view name = option.substr(0, equals);
+		const auto key = map.try_key(name);
+		const bool has_next_value = i + 1 < argc && std::string_view(argv[i + 1]).substr(0, 2) != "--";
+		std::string_view value;
+		if (equals != std::string_view::npos) {
+			value = option.substr(equals + 1);
+		} else if (key && detail::is_flag<MAP>(key->index()) && !has_next_value) {
+			value = "true";
+		} else if (has_next_value) {
+			value = argv[++i];
+		} else if (key) {
+			throw std::invalid_argument("No value given for option --" + std::string(name));
+		}
+		n_bound += detail::bind_value<detail::PlainText>(map, key, name, value, policy) ? 1 : 0;
+	}
+	return n_bound;
+}
+
+template <typename MAP>
+size_t bind_ini(std::string_view ini, MAP &map, std::string_view section, UnknownParameterPolicy policy) {
+	size_t n_bound = 0;
+	std::string_view current_section;
+	while (!ini.empty()) {
+		const size_t line_end = ini.find('\n');
+		const std::string_view line = detail::trim(ini.substr(0, line_end));
+		ini.remove_prefix(line_end == std::string_view::npos ? ini.size() : line_end + 1);
+
+		if (line.empty() || line[0] == ';' || line[0] == '#') {
+			continue;
+		}
+		if (line[0] == '[') {
+			if (line.back() != ']') {
+				throw std::runtime_error("Malformed INI: unterminated section header " + std::string(line));
+			}
+			current_section = detail::trim(line.substr(1, line.size() - 2));
+			continue;
+		}
+		if (current_section != section) {
+			continue;
+		}
+		const size_t equals = line.find('=');
+		if (equals == std::string_view::npos) {
+			throw std::runtime_error("Malformed INI: expected name = value, got " + std::string(line));
+		}
+		std::string_view value = detail::trim(line.substr(equals + 1));
+		if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+			value = value.substr(1, value.size() - 2);
+		}
+		const std::string_view name = detail::trim(line.substr(0, equals));
+		n_bound += detail::bind_value<detail::PlainText>(map, name, value, policy) ? 1 : 0;
+	}
+	return n_bound;
+}
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,167 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef PARALLEL_SUBMIT_H
+#define PARALLEL_SUBMIT_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ParameterMap.h"
+#include "WorkStealingPool.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Determines what \a submit_parallel does when a call throws.
+ */
+enum class ExceptionPolicy {
+	cancel,   ///< Skip all calls which have not started yet, then rethrow the first exception.
+	complete  ///< Make all remaining calls, then rethrow the first exception.
+};
+
+/**
+ *  @brief Options of \a submit_parallel.
+ */
+struct ParallelSubmitOptions {
+	size_t grain_size = 0;  ///< Number of maps submitted per task, 0 to choose one based on the executor size.
+	ExceptionPolicy on_exception = ExceptionPolicy::cancel;
+};
+
+/**
+ *  @brief Submits every map in \a maps to \a function, spreading the calls over the workers of \a executor.
+ *  @param maps A random access range of parameter maps (or anything else providing a const \a submit member).
+ *  @param function The function to be called, it is called concurrently from multiple threads.
+ *  @param executor The executor running the calls, e.g. a WorkStealingPool. It should provide \a execute(task) and
+ *    \a size(), the number of tasks it runs concurrently.
+ *  @param options The grain size and exception policy.
+ *  @return The return values of the calls in the order of \a maps, or nothing if \a function returns void.
+ *  @throw The first exception thrown by a call to \a submit, after all started calls have finished.
+ *
+ *  The maps are split into chunks of \a grain_size maps, which are claimed one at a time by tasks running on the
+ *  executor as well as by the calling thread. The calling thread therefore never idles, and calling submit_parallel
+ *  from within a task running on the same executor does not deadlock.
+ */
+template <typename RANGE, typename FUNCTION, typename EXECUTOR>
+auto submit_parallel(const RANGE &maps,
+										 FUNCTION &&function,
+										 EXECUTOR &executor,
+										 ParallelSubmitOptions options = ParallelSubmitOptions{});
+
+
+/////////////////////////////////////////////////////////////
+//////////////////    submit_parallel   /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief State shared between the caller of submit_parallel and the tasks it executes.
+ *
+ *  Tasks may start after all chunks have been completed and submit_parallel returned, so they own the state and only
+ *  use \a run_chunk (which refers to the caller's stack) after successfully claiming a chunk.
+ */
+struct ParallelSubmitState {
+	explicit ParallelSubmitState(size_t n_chunks) : n_chunks(n_chunks) {}
+
+	const size_t n_chunks;
+	std::function<void(size_t)> run_chunk;
+	std::atomic<size_t> next_chunk{0};
+	std::atomic<bool> cancelled{false};
+
+	std::mutex mutex;
+	std::condition_variable all_completed;
+	size_t n_completed = 0;
+	std::exception_ptr first_exception;
+
+	void work() {
+		for (size_t chunk = next_chunk++; chunk < n_chunks; chunk = next_chunk++) {
+			run_chunk(chunk);
+			std::lock_guard<std::mutex> lock(mutex);
+			if (++n_completed == n_chunks) {
+				all_completed.notify_all();
+			}
+		}
+	}
+
+	void record_exception(ExceptionPolicy policy) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!first_exception) {
+			first_exception = std::current_exception();
+		}
+		if (policy == ExceptionPolicy::cancel) {
+			cancelled = true;
+		}
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		detail::wait(all_completed, lock, [&] { return n_completed == n_chunks; });
+	}
+};
+}  // namespace detail
+
+template <typename RANGE, typename FUNCTION, typename EXECUTOR>
+auto submit_parallel(const RANGE &maps, FUNCTION &&function, EXECUTOR &executor, ParallelSubmitOptions options) {
+	const auto first = std::begin(maps);
+	const size_t n_maps = static_cast<size_t>(std::distance(first, std::end(maps)));
+	using result_t = decltype(first->submit(function));
+	constexpr bool returns_void = std::is_void_v<result_t>;
+	using result_storage_t = std::conditional_t<returns_void, bool, std::optional<result_t>>;
+
+	const size_t n_workers = std::max<size_t>(executor.size(), 1);
+	const size_t grain_size = options.grain_size > 0 ? options.grain_size
+																									 : std::max<size_t>(1, n_maps / (4 * (n_workers + 1)));
+	const size_t n_chunks = (n_maps + grain_size - 1) / grain_size;
+
+	std::vector<result_storage_t> results(returns_void ? 0 : n_maps);
+	auto state = std::make_shared<detail::ParallelSubmitState>(n_chunks);
+	state->run_chunk = [&](size_t chunk) {
+		const size_t end = std::min(n_maps, (chunk + 1) * grain_size);
+		for (size_t i = chunk * grain_size; i < end && !state->cancelled.load(std::memory_order_relaxed); ++i) {
+			try {
+				if constexpr (returns_void) {
+					std::next(first, i)->submit(function);
+				} else {
+					results[i].emplace(std::next(first, i)->submit(function));
+				}
+			} catch (...) {
+				state->record_exception(options.on_exception);
+			}
+		}
+	};
+
+	for (size_t i = 0; i < std::min(n_chunks, n_workers); ++i) {
+		executor.execute([state] { state->work(); });
+	}
+	state->work();
+	state->wait();
+
+	if (state->first_exception) {
+		std::rethrow_exception(state->first_exception);
+	}
+	if constexpr (!returns_void) {
+		std::vector<result_t> ordered_results;
+		ordered_results.reserve(n_maps);
+		for (auto &result : results) {
+			ordered_results.push_back(std::move(*result));
+		}
+		return ordered_results;
+	}
+}
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,186 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef PARAMETER_BINDING_H
+#define PARAMETER_BINDING_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Determines what a binder does with a value whose name does not match any parameter of the map.
+ */
+enum class UnknownParameterPolicy {
+	ignore,  ///< Skip the value.
+	reject   ///< Fail binding, reported the way the binder reports other errors.
+};
+
+/////////////////////////////////////////////////////////////
+//////////////////   Binding utilities  /////////////////////
+/////////////////////////////////////////////////////////////
+
+// Shared by the binders which read parameter values from text (XmlBinder.h, JsonBinder.h, KeyValueBinder.h). A
+// binder supplies a TEXT_FORMAT with
+//   static bool is_escaped(std::string_view text): whether \a text has to be unescaped before it can be used as a string.
+//   static void unescape(std::string_view text, std::string &out): appends the unescaped \a text to \a out.
+
+namespace detail {
+constexpr std::string_view trim(std::string_view text) noexcept {
+	constexpr std::string_view whitespace = " \t\r\n";
+	const auto first = text.find_first_not_of(whitespace);
+	if (first == std::string_view::npos) {
+		return {};
+	}
+	return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+}
+
+/**
+ *  @brief Appends the UTF-8 encoding of \a code_point to \a out.
+ */
+inline void append_utf8(std::uint32_t code_point, std::string &out) {
+	if (code_point < 0x80) {
+		out.push_back(static_cast<char>(code_point));
+	} else if (code_point < 0x800) {
+		out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+		out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+	} else if (code_point < 0x10000) {
+		out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+		out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+	} else {
+		out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+		out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+	}
+}
+
+/**
+ *  @brief Converts \a text into a \a T without allocating, except for the characters of a std::string.
+ *  @return The value, or nothing if \a text is not a valid \a T or \a T can not be read from text.
+ *
+ *  Supports bool ("true", "false", "1", "0"), arithmetic types (using std::from_chars), std::string and
+ *  std::string_view. A std::string_view refers to \a text itself, which therefore should not be escaped.
+ */
+template <typename TEXT_FORMAT, typename T>
+std::optional<T> try_parse_value(std::string_view text) {
+	if constexpr (std::is_same_v<T, bool>) {
+		text = trim(text);
+		if (text == "true" || text == "1") {
+			return true;
+		}
+		if (text == "false" || text == "0") {
+			return false;
+		}
+		return std::nullopt;
+	} else if constexpr (std::is_arithmetic_v<T>) {
+		text = trim(text);
+		T value{};
+#if defined(__cpp_lib_to_chars)
+		constexpr bool use_from_chars = true;
+#else
+		constexpr bool use_from_chars = !std::is_floating_point_v<T>;
+#endif
+		if constexpr (use_from_chars) {
+			const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+			if (error != std::errc{} || end != text.data() + text.size()) {
+				return std::nullopt;
+			}
+		} else {
+			char buffer[64];
+			if (text.empty() || text.size() >= sizeof(buffer)) {
+				return std::nullopt;
+			}
+			text.copy(buffer, text.size());
+			buffer[text.size()] = '\0';
+			char *end = nullptr;
+			value = static_cast<T>(std::strtold(buffer, &end));
+			if (end != buffer + text.size()) {
+				return std::nullopt;
+			}
+		}
+		return value;
+	} else if constexpr (std::is_same_v<T, std::string>) {
+		if (!TEXT_FORMAT::is_escaped(text)) {
+			return std::string(text);
+		}
+		std::string value;
+		value.reserve(text.size());
+		TEXT_FORMAT::unescape(text, value);
+		return value;
+	} else if constexpr (std::is_same_v<T, std::string_view>) {
+		if (TEXT_FORMAT::is_escaped(text)) {
+			return std::nullopt;
+		}
+		return text;
+	} else {
+		return std::nullopt;
+	}
+}
+
+/**
+ *  @brief Converts \a text into a \a T, see \a try_parse_value.
+ *  @throw std::invalid_argument if \a text is not a valid \a T or \a T can not be read from text.
+ */
+template <typename TEXT_FORMAT, typename T>
+T parse_value(std::string_view text) {
+	auto value = try_parse_value<TEXT_FORMAT, T>(text);
+	if (!value) {
+		throw std::invalid_argument("Unable to parse parameter value \"" + std::string(text) + "\"");
+	}
+	return std::move(*value);
+}
+
+/**
+ *  @brief Parses \a text into the parameter of \a map named \a name.
+ *  @return Whether a parameter was set, false if there is no parameter named \a name and \a policy is ignore.
+ *  @throw std::invalid_argument if \a text can not be parsed into the parameter, or if there is no parameter named
+ *    \a name and \a policy is reject.
+ */
+template <typename TEXT_FORMAT, typename MAP>
+bool bind_value(MAP &map, std::string_view name, std::string_view text, UnknownParameterPolicy policy) {
+	return bind_value<TEXT_FORMAT>(map, map.try_key(name), name, text, policy);
+}
+
+/**
+ *  @brief Parses \a text into the parameter of \a map identified by \a key, the result of map.try_key(name).
+ *
+ *  For binders which already resolved \a name, see \a bind_value above.
+ */
+template <typename TEXT_FORMAT, typename MAP>
+bool bind_value(MAP &map,
+								const Expected<typename MAP::key_type> &key,
+								std::string_view name,
+								std::string_view text,
+								UnknownParameterPolicy policy) {
+	if (!key) {
+		if (policy == UnknownParameterPolicy::reject) {
+			throw std::invalid_argument("No parameter named \"" + std::string(name) + "\"");
+		}
+		return false;
+	}
+	visit_index<MAP::size()>(key->index(), [&](auto i) {
+		using value_t = std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<i.value>>>;
+		map.template set<i.value>(parse_value<TEXT_FORMAT, value_t>(text));
+	});
+	return true;
+}
+}  // namespace detail
+
+}  // namespace qbouts
+
+#endif
@@ -7,21 +7,416 @@
 #define PARAMETER_MAP_H
 
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <new>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 namespace qbouts {
 namespace detail {
-template <class F, class Tuple>
-constexpr decltype(auto) apply_optionals(F &&f, Tuple &&t);
+template <typename... TYPES>
+class ParameterStorage;
 
 template <int First, int Last, typename Lambda>
 inline void static_for(Lambda const &f);
+
+template <size_t N, typename FUNCTION>
+void visit_index(size_t index, FUNCTION &&func);
+
+template <size_t N>
+class RuntimeNames;
+
+template <typename NAMES>
+class CompileTimeNames;
+
+template <size_t N>
+class SchemaNames;
+
+template <const auto &SCHEMA>
+class BoundSchemaNames;
+
+template <size_t N>
+class PerfectHashTable;
+
+constexpr std::uint64_t hash_name(std::string_view name) noexcept;
+
+constexpr std::uint64_t combine_hashes(std::uint64_t seed, std::uint64_t hash) noexcept;
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+constexpr std::uint64_t fingerprint_of() noexcept;
+
+template <typename NAME_TABLE>
+inline constexpr bool has_compile_time_names_v = false;
+template <typename NAMES>
+inline constexpr bool has_compile_time_names_v<CompileTimeNames<NAMES>> = true;
+}  // namespace detail
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+class BasicParameterMap;
+
+template <typename MAP, typename DEFAULTS>
+class ParameterMapWithDefaults;
+
+namespace detail {
+/**
+ *  @brief Whether \a MAP is a (possibly const) BasicParameterMap with parameters \a PARAMETERS, regardless of its names.
+ */
+template <typename MAP, typename... PARAMETERS>
+inline constexpr bool is_map_with_parameters_v = false;
+template <typename NAME_TABLE, typename... PARAMETERS>
+inline constexpr bool is_map_with_parameters_v<BasicParameterMap<NAME_TABLE, PARAMETERS...>, PARAMETERS...> = true;
+template <typename NAME_TABLE, typename... PARAMETERS>
+inline constexpr bool is_map_with_parameters_v<const BasicParameterMap<NAME_TABLE, PARAMETERS...>, PARAMETERS...> =
+		true;
+}  // namespace detail
+
+/**
+ *  @brief A ParameterMap whose parameter names are supplied to the constructor at runtime.
+ *
+ *  This is the default flavour of BasicParameterMap, see its documentation for details.
+ */
+template <typename... PARAMETERS>
+using ParameterMap = BasicParameterMap<detail::RuntimeNames<sizeof...(PARAMETERS)>, PARAMETERS...>;
+
+/**
+ *  @brief A ParameterMap whose parameter names are fixed at compile time.
+ *  @tparam NAMES A type with a static constexpr member \a value holding a std::array<std::string_view, N> with the
+ *    names of the parameters, in order. With C++20 \a ParameterNames<"a", "b"> can be used for this purpose.
+ *
+ *  A perfect hash table of the names is generated at compile time, so identifying a parameter by its name costs a
+ *  single hash of the name, one string comparison and a jump table dispatch, regardless of the number of parameters.
+ *  Instances do not store any names and are default constructed.
+ */
+template <typename NAMES, typename... PARAMETERS>
+using StaticParameterMap = BasicParameterMap<detail::CompileTimeNames<NAMES>, PARAMETERS...>;
+
+/**
+ *  @brief Tag type of \a literal_names.
+ */
+struct LiteralNames {
+	explicit LiteralNames() = default;
+};
+
+/**
+ *  @brief Passed before the names to a ParameterMap constructor to reference the names instead of copying them.
+ *
+ *  Only character arrays are accepted, which must outlive the map and all of its copies, as string literals do.
+ *  Construction then does not allocate, e.g. ParameterMap<int, bool> map{literal_names, "size", "flip"};
+ */
+inline constexpr LiteralNames literal_names{};
+
+/**
+ *  @brief An immutable set of N parameter names, shared by all maps constructed from it.
+ *
+ *  The schema owns the names, stored in a single pool, and a perfect hash table of them which is built on
+ *  construction. Maps referring to a schema do not store any names themselves: a \a SchemaParameterMap stores a
+ *  pointer to its schema, a \a BoundParameterMap refers to a schema with static storage duration through its type.
+ *  A schema can therefore neither be copied nor moved and should outlive all maps referring to it.
+ */
+template <size_t N>
+class ParameterSchema {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param names The names of the parameters, in order.
+	 *  @throw std::invalid_argument if the names are not unique.
+	 */
+	template <typename... NAMES>
+	explicit ParameterSchema(const NAMES &... names) requires(
+			sizeof...(NAMES) == N && (std::is_convertible_v<NAMES, std::string_view> && ...));
+
+	ParameterSchema(const ParameterSchema &) = delete;
+	ParameterSchema &operator=(const ParameterSchema &) = delete;
+
+	/**
+	 *  @brief Returns the index of the parameter named \a name or N if there is none.
+	 */
+	[[nodiscard]] size_t index_of(const std::string_view &name) const noexcept;
+
+	/**
+	 *  @brief Returns the name of the parameter at \a index.
+	 *  @throw std::out_of_range if \a index is not smaller than N.
+	 */
+	[[nodiscard]] std::string_view name(size_t index) const;
+
+	[[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+private:
+	std::unique_ptr<char[]> m_pool;
+	std::array<std::string_view, N> m_names;
+	detail::PerfectHashTable<N> m_table;
+
+	explicit ParameterSchema(const std::array<std::string_view, N> &names);
+
+	static std::array<std::string_view, N> copy_to_pool(const std::array<std::string_view, N> &names, char *pool);
+};
+
+/**
+ *  @brief A ParameterMap which refers to a ParameterSchema for its names, e.g. SchemaParameterMap<int, bool>{schema}.
+ *
+ *  Instances store the values and a single pointer to the schema.
+ */
+template <typename... PARAMETERS>
+using SchemaParameterMap = BasicParameterMap<detail::SchemaNames<sizeof...(PARAMETERS)>, PARAMETERS...>;
+
+/**
+ *  @brief A ParameterMap whose names are taken from a ParameterSchema with static storage duration, bound by its type.
+ *
+ *  Instances only store the values and are default constructed, e.g.
+ *    inline const ParameterSchema<2> texture_schema{"path", "flip"};
+ *    BoundParameterMap<texture_schema, const std::string &, bool> params;
+ */
+template <const auto &SCHEMA, typename... PARAMETERS>
+using BoundParameterMap = BasicParameterMap<detail::BoundSchemaNames<SCHEMA>, PARAMETERS...>;
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+namespace detail {
+template <size_t N>
+struct FixedName {
+	constexpr FixedName(const char (&name)[N]) {
+		for (size_t i = 0; i < N; ++i) {
+			data[i] = name[i];
+		}
+	}
+	constexpr std::string_view view() const { return {data, N - 1}; }
+	char data[N]{};
+};
+}  // namespace detail
+
+/**
+ *  @brief Supplies parameter names for a StaticParameterMap as template arguments, e.g. ParameterNames<"a", "b">.
+ */
+template <detail::FixedName... NAMES>
+struct ParameterNames {
+	static constexpr std::array<std::string_view, sizeof...(NAMES)> value{NAMES.view()...};
+};
+#endif
+
+/////////////////////////////////////////////////////////////
+//////////////////       Expected       /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief The reasons for which an operation on a ParameterMap can fail, returned by the \a try_ member functions.
+ */
+enum class ParameterError : std::uint8_t {
+	unknown_name,        ///< No parameter has the given name.
+	index_out_of_range,  ///< The given index is not smaller than the number of parameters.
+	incompatible_type,   ///< The parameter can not be set from, or retrieved as, the given type.
+	no_value_stored,     ///< No value is stored for (one of) the parameter(s).
+	invalid_value,       ///< A value read from text can not be converted to the type of its parameter.
+	malformed_input      ///< Text from which values are read is not well-formed.
+};
+
+/**
+ *  @brief Returns a static description of \a error.
+ */
+constexpr const char *describe(ParameterError error) noexcept {
+	switch (error) {
+		case ParameterError::unknown_name: return "No parameters match the given name";
+		case ParameterError::index_out_of_range: return "Parameter index out of range";
+		case ParameterError::incompatible_type: return "Parameter type is incompatible";
+		case ParameterError::no_value_stored: return "Parameter does not have a stored value";
+		case ParameterError::invalid_value: return "Parameter value can not be converted to the parameter type";
+		case ParameterError::malformed_input: return "Input is malformed";
+	}
+	return "";
+}
+
+/**
+ *  @brief Holds either a \a T (which may be a reference or void) or the ParameterError explaining why there is none.
+ */
+template <typename T>
+class [[nodiscard]] Expected {
+public:
+	using value_type = T;
+
+	Expected(T value) : m_storage(store(std::forward<T>(value))) {}
+	Expected(ParameterError error) : m_storage(error) {}
+
+	bool has_value() const noexcept { return m_storage.index() == 0; }
+	explicit operator bool() const noexcept { return has_value(); }
+
+	/**
+	 *  @brief Returns the error, only valid if no value is held.
+	 */
+	ParameterError error() const noexcept { return *std::get_if<ParameterError>(&m_storage); }
+
+	/**
+	 *  @brief Returns the value.
+	 *  @throw std::logic_error if no value is held.
+	 */
+	decltype(auto) value() & { return get(throw_if_error()); }
+	decltype(auto) value() const & { return get(throw_if_error()); }
+	decltype(auto) value() && { return static_cast<T &&>(get(throw_if_error())); }
+
+	decltype(auto) operator*() & noexcept { return get(*this); }
+	decltype(auto) operator*() const & noexcept { return get(*this); }
+	auto operator-> () noexcept { return &get(*this); }
+	auto operator-> () const noexcept { return &get(*this); }
+
+private:
+	using storage_t = std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T> *, T>;
+	static_assert(!std::is_same_v<std::remove_cv_t<storage_t>, ParameterError>);
+	std::variant<storage_t, ParameterError> m_storage;
+
+	static storage_t store(T &&value) {
+		if constexpr (std::is_reference_v<T>) {
+			return &value;
+		} else {
+			return std::move(value);
+		}
+	}
+
+	template <typename SELF>
+	static decltype(auto) get(SELF &self) noexcept {
+		if constexpr (std::is_reference_v<T>) {
+			return static_cast<T>(**std::get_if<0>(&self.m_storage));
+		} else {
+			return (*std::get_if<0>(&self.m_storage));
+		}
+	}
+
+	const Expected &throw_if_error() const & {
+		if (!has_value()) {
+			throw std::logic_error(describe(error()));
+		}
+		return *this;
+	}
+	Expected &throw_if_error() & {
+		std::as_const(*this).throw_if_error();
+		return *this;
+	}
+};
+
+/**
+ *  @brief Holds either nothing (success) or the ParameterError explaining the failure.
+ */
+template <>
+class [[nodiscard]] Expected<void> {
+public:
+	using value_type = void;
+
+	Expected() noexcept = default;
+	Expected(ParameterError error) noexcept : m_error(error), m_has_error(true) {}
+
+	bool has_value() const noexcept { return !m_has_error; }
+	explicit operator bool() const noexcept { return has_value(); }
+	ParameterError error() const noexcept { return m_error; }
+
+	/**
+	 *  @throw std::logic_error if an error is held.
+	 */
+	void value() const {
+		if (m_has_error) {
+			throw std::logic_error(describe(m_error));
+		}
+	}
+
+private:
+	ParameterError m_error{};
+	bool m_has_error = false;
+};
+
+/////////////////////////////////////////////////////////////
+//////////////////       Borrowed       /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief Declares a parameter which refers to a caller-owned \a T instead of storing a copy of it.
+ *
+ *  A map with a Borrowed<const std::string> parameter stores a pointer to the string it is given and passes the string
+ *  itself (as a \a T &) to the submitted function. Only lvalues of \a T can be stored, which must outlive the map or
+ *  be replaced before the map is submitted. Getters return a reference to the borrowed value.
+ */
+template <typename T>
+class Borrowed {
+	static_assert(!std::is_reference_v<T>, "Borrowed<T> refers to a T, T should not be a reference");
+
+public:
+	constexpr Borrowed(T &value) noexcept : m_value(&value) {}
+	Borrowed(std::remove_cv_t<T> &&) = delete;
+
+	constexpr operator T &() const noexcept { return *m_value; }
+	constexpr T &get() const noexcept { return *m_value; }
+
+private:
+	T *m_value;
+};
+
+namespace detail {
+template <typename T>
+inline constexpr bool is_borrowed_v = false;
+template <typename T>
+inline constexpr bool is_borrowed_v<Borrowed<T>> = true;
+
+/**
+ *  @brief The type of the value held by a stored \a T: the borrowed type for Borrowed<T>, \a T itself otherwise.
+ */
+template <typename T>
+struct borrowed_value {
+	using type = T;
+};
+template <typename T>
+struct borrowed_value<Borrowed<T>> {
+	using type = std::remove_cv_t<T>;
+};
+template <typename T>
+using borrowed_value_t = typename borrowed_value<T>::type;
+
+template <typename T>
+constexpr const T &unwrap_borrowed(const T &value) noexcept {
+	return value;
+}
+template <typename T>
+constexpr T &unwrap_borrowed(const Borrowed<T> &value) noexcept {
+	return value.get();
+}
 }  // namespace detail
 
+/**
+ *  @brief Determines which value is kept by \a merge_from when both maps have a value stored for a parameter.
+ */
+enum class MergePolicy {
+	keep_existing,  ///< Keep the value of the map merged into, only parameters without a value are taken over.
+	overwrite       ///< Take over the value of the map merged from.
+};
+
+/////////////////////////////////////////////////////////////
+//////////////////     ParameterKey     /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief A pre-resolved handle to a parameter of a \a MAP, obtained using \a MAP::key.
+ *
+ *  Identifying a parameter using a key does not require hashing or comparing its name: the key holds the index of the
+ *  parameter and can only be used with maps of type \a MAP. A key can be reused for every instance of \a MAP.
+ */
+template <typename MAP>
+class ParameterKey {
+public:
+	/**
+	 *  @brief Returns the index of the parameter identified by the key.
+	 */
+	constexpr size_t index() const noexcept { return m_index; }
+
+	constexpr bool operator==(const ParameterKey &other) const noexcept { return m_index == other.m_index; }
+	constexpr bool operator!=(const ParameterKey &other) const noexcept { return m_index != other.m_index; }
+
+private:
+	friend MAP;
+	constexpr explicit ParameterKey(size_t index) noexcept : m_index(index) {}
+	size_t m_index;
+};
+
 /////////////////////////////////////////////////////////////
 //////////////////     ParameterMap     /////////////////////
 /////////////////////////////////////////////////////////////
@@ -41,32 +436,80 @@ inline void static_for(Lambda const &f);
  *  Using the \a submit member function the parameters can be 'submitted' to a supplied function: The function will be
  *  called with the stored parameters.
  *
+ *  \par Names
+ *  How names are stored and looked up is determined by \a NAME_TABLE. Use the \a ParameterMap alias to supply names
+ *  to the constructor at runtime, or the \a StaticParameterMap alias to fix them at compile time.
+ *
  *  \par Performance
  *  Care has been taken to avoid making unnecessary copies of parameters or string comparisons.
  *  When using a ParameterMap of in a performance sensitive part of your code be aware of the following:
- *  - Any operations where parameters are identified by their name ( \a set, \a get, \a is_set) will compute an
- *    std::hash of the given \a name, which takes linear time in the length of the name. Where possible,
+ *  - Any operations where parameters are identified by their name ( \a set, \a get, \a is_set) will compute a
+ *    hash of the given \a name, which takes linear time in the length of the name. Where possible,
  *    prefer the use of the index based variants of these functions or build the parameter map outside of
- *    the performance critical section of your code.
+ *    the performance critical section of your code. A \a StaticParameterMap resolves a hashed name using a
+ *    perfect hash table, a \a ParameterMap compares it against the hash of every parameter name.
+ *    Names which are used repeatedly can be resolved once using \a key, the resulting key can be used with every
+ *    instance of the same map type without any hashing.
  *  - For most functions the overhead of using \a submit compared to calling the function directly will be negligible.
- *    There is however one small exception to be aware of: function calls made using \a submit do not benefit from move
- *    semantics. To be specific: For functions that accept parameters by rvalue reference (e.g. int&&), a copy of the
- *    stored parameter will be made. This is required as the parameter map may not be modified by the \a submit call.
+ *    There is however one small exception to be aware of: function calls made using \a submit on an lvalue map do not
+ *    benefit from move semantics, as the parameter map may not be modified by the \a submit call. Use
+ *    \a submit_and_consume (or call \a submit on an rvalue map) to move the stored values into the function instead,
+ *    which leaves the map cleared.
  *
  */
-template <typename... PARAMETERS>
-class ParameterMap {
+template <typename NAME_TABLE, typename... PARAMETERS>
+class BasicParameterMap : private NAME_TABLE {
 public:
+	using key_type = ParameterKey<BasicParameterMap>;
+
 	/**
 	 *  @brief Constructor.
 	 *  @param names The names of the parameters represented by the parameter map.
 	 *
 	 *  Constructor initializes the ParameterMap given a set of parameter names.
 	 *  Exactly one name should be supplied per parameter, compilation will fail otherwise.
+	 *  Maps with compile-time names (see \a StaticParameterMap) are constructed without any names.
+	 */
+	template <typename... PARAM_NAMES>
+	explicit BasicParameterMap(PARAM_NAMES &&... names) requires(
+			(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+			std::is_constructible_v<NAME_TABLE, PARAM_NAMES...>);
+
+	/**
+	 *  @brief Constructor referencing the names instead of copying them, see \a literal_names.
+	 *  @param names The names of the parameters, which must outlive the map and all of its copies.
 	 */
 	template <typename... PARAM_NAMES>
-	explicit ParameterMap(PARAM_NAMES &&... names) requires(sizeof...(PARAMETERS) == sizeof...(PARAM_NAMES));
+	BasicParameterMap(LiteralNames, PARAM_NAMES &&... names) requires(
+			(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+			std::is_constructible_v<NAME_TABLE, LiteralNames, PARAM_NAMES...>);
+
+	/**
+	 *  @brief Constructor of a SchemaParameterMap.
+	 *  @param schema The names of the parameters, which must outlive the map and all of its copies.
+	 */
+	template <size_t N>
+	explicit BasicParameterMap(const ParameterSchema<N> &schema) noexcept requires(
+			std::is_constructible_v<NAME_TABLE, const ParameterSchema<N> &>);
+
+
+	/****************************************************************************/
+	/*********************************** Key ************************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Resolves the parameter identified by \a name into a key.
+	 *  @param name Name of the parameter.
+	 *  @return A key which can be passed to \a set, \a get and \a is_set instead of the name.
+	 *  @throw  std::invalid_argument if no parameters match @a name.
+	 */
+	[[nodiscard]] key_type key(const std::string_view &name) const;
 
+	/**
+	 *  @brief Returns the name of the parameter at \a index.
+	 *  @throw  std::out_of_range if @a index is an invalid index.
+	 */
+	[[nodiscard]] std::string_view name(size_t index) const;
 
 	/****************************************************************************/
 	/*********************************** Set ************************************/
@@ -90,6 +533,15 @@ public:
 	template <typename T>
 	void set(size_t index, T &&value);
 
+	/**
+	 *  @brief Sets the value of the parameter identified by \a key.
+	 *  @param key Key of the parameter to which the @a value should be assigned.
+	 *  @param value The value which should be stored for this parameter.
+	 *  @throw  std::invalid_argument if the parameter type is incompatible to @a value.
+	 */
+	template <typename T>
+	void set(key_type key, T &&value);
+
 	/**
 	 *  @brief Sets the value of the parameter identified by \a INDEX.
 	 *  @tparam INDEX The index of the parameter to which the @a value should be assigned (starting at 0).
@@ -100,6 +552,48 @@ public:
 	template <size_t INDEX, typename T>
 	void set(T &&value);
 
+	/****************************************************************************/
+	/********************************* Emplace **********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Constructs the value of the parameter identified by \a name in place.
+	 *  @param name Name of the parameter whose value should be constructed.
+	 *  @param args The arguments forwarded to the constructor of the parameter.
+	 *  @throw  std::invalid_argument if no parameters match @a name or the parameter is not constructible from @a args.
+	 *
+	 *  Any previously stored value is destroyed first.
+	 */
+	template <typename... ARGS>
+	void emplace(const std::string_view &name, ARGS &&... args);
+
+	/**
+	 *  @brief Constructs the value of the parameter identified by \a index in place.
+	 *  @param index The index of the parameter whose value should be constructed (starting at 0).
+	 *  @param args The arguments forwarded to the constructor of the parameter.
+	 *  @throw  std::out_of_range if @a index is an invalid index.
+	 *  @throw  std::invalid_argument if the parameter is not constructible from @a args.
+	 */
+	template <typename... ARGS>
+	void emplace(size_t index, ARGS &&... args);
+
+	/**
+	 *  @brief Constructs the value of the parameter identified by \a key in place.
+	 *  @param key Key of the parameter whose value should be constructed.
+	 *  @param args The arguments forwarded to the constructor of the parameter.
+	 *  @throw  std::invalid_argument if the parameter is not constructible from @a args.
+	 */
+	template <typename... ARGS>
+	void emplace(key_type key, ARGS &&... args);
+
+	/**
+	 *  @brief Constructs the value of the parameter identified by \a INDEX in place.
+	 *  @tparam INDEX The index of the parameter whose value should be constructed (starting at 0).
+	 *  @param args The arguments forwarded to the constructor of the parameter.
+	 */
+	template <size_t INDEX, typename... ARGS>
+	void emplace(ARGS &&... args) requires(INDEX < sizeof...(PARAMETERS));
+
 	/****************************************************************************/
 	/*********************************** Get ************************************/
 	/****************************************************************************/
@@ -126,6 +620,17 @@ public:
 	template <typename T>
 	[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &get(size_t index) const;
 
+	/**
+	 *  @brief Gets the value of the parameter identified by \a key as a const (read-only) reference.
+	 *  @tparam T The type of the parameter to be retrieved.
+	 *  @param key Key of the parameter to be retrieved.
+	 *  @return The value of the parameter as a const reference to @a T.
+	 *  @throw  std::invalid_argument if the parameter type is incompatible to @a T.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &get(key_type key) const;
+
 	/**
 	 *  @brief Gets the value of the parameter identified by \a INDEX as a const (read-only) reference.
 	 *  @tparam INDEX The index of the parameter to be retrieved.
@@ -133,7 +638,7 @@ public:
 	 *  @throw  std::runtime_error if no value is stored for the parameter.
 	 */
 	template <size_t INDEX>
-	[[nodiscard]] auto get() const requires(INDEX < sizeof...(PARAMETERS));
+	[[nodiscard]] decltype(auto) get() const requires(INDEX < sizeof...(PARAMETERS));
 
 
 	/****************************************************************************/
@@ -146,7 +651,7 @@ public:
 	 *  @return True if a value is stored for the parameter, false otherwise.
 	 *  @throw  std::invalid_argument if no parameters match @a name.
 	 */
-	[[nodiscard]] bool is_set(const std::string_view &name);
+	[[nodiscard]] bool is_set(const std::string_view &name) const;
 
 	/**
 	 *  @brief Returns whether a value is set for the parameter identified by \a index.
@@ -154,7 +659,14 @@ public:
 	 *  @return True if a value is stored for the parameter, false otherwise.
 	 *  @throw  std::out_of_range if @a index is an invalid index.
 	 */
-	[[nodiscard]] bool is_set(size_t index);
+	[[nodiscard]] bool is_set(size_t index) const;
+
+	/**
+	 *  @brief Returns whether a value is set for the parameter identified by \a key.
+	 *  @param key Key of the parameter to check.
+	 *  @return True if a value is stored for the parameter, false otherwise.
+	 */
+	[[nodiscard]] bool is_set(key_type key) const noexcept;
 	/**
 	 *  @brief Returns whether a value is set for the parameter identified by \a INDEX.
 	 *  @tparam INDEX Index of the parameter to check.
@@ -182,6 +694,34 @@ public:
 	 */
 	static constexpr size_t size() noexcept { return n_parameters; }
 
+	/**
+	 *  @brief The type of the parameter at \a INDEX, as declared in the template arguments of the map.
+	 */
+	template <size_t INDEX>
+	using parameter_type = std::tuple_element_t<INDEX, std::tuple<PARAMETERS...>>;
+
+	/****************************************************************************/
+	/******************************* Fingerprint ********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief A 64 bit fingerprint of the stored parameter types, their layout and, for maps with compile-time names,
+	 *    the names.
+	 *
+	 *  Fingerprints are computed at compile time and are identical for maps with the same parameter types (and names),
+	 *  compiled with the same compiler for the same platform, regardless of the process. Comparing them checks in O(1)
+	 *  whether values written by one map can be loaded into another, e.g. before reading a serialized map.
+	 */
+	static constexpr std::uint64_t fingerprint = detail::fingerprint_of<NAME_TABLE, PARAMETERS...>();
+
+	/**
+	 *  @brief Returns \a fingerprint combined with the names of the parameters.
+	 *
+	 *  Equal to \a fingerprint for maps with compile-time names. Maps with the same names and parameter types have the
+	 *  same schema fingerprint regardless of how their names are supplied.
+	 */
+	[[nodiscard]] std::uint64_t schema_fingerprint() const noexcept;
+
 	/****************************************************************************/
 	/********************************* submit ***********************************/
 	/****************************************************************************/
@@ -205,19 +745,193 @@ public:
 	 *    As such, the overhead of \a submit should be negligible in almost all settings.
 	 */
 	template <typename FUNCTION>
-	auto submit(FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
+	auto submit(FUNCTION &&function) const &requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
 
-private:
-	static constexpr size_t n_parameters = sizeof...(PARAMETERS);
-	std::array<std::size_t, n_parameters> m_parameter_name_hashes;
-	using parameter_tuple_t = std::tuple<std::optional<std::remove_cv_t<std::remove_reference_t<PARAMETERS>>>...>;
-	parameter_tuple_t m_stored_values;
+	/**
+	 *  @brief Calls the function with the stored parameters, moving them into the function.
+	 *  @tparam FUNCTION The function to be called.
+	 *  @return The return value of returned by the call to the supplied function.
+	 *  @throw Throws a std::runtime_error if not all parameters have values stored
+	 *
+	 *  Equivalent to \a submit_and_consume, selected when submitting an rvalue map: std::move(map).submit(f).
+	 */
+	template <typename FUNCTION>
+	auto submit(FUNCTION &&function) && requires(
+			std::is_invocable_v<FUNCTION, std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &&...>);
 
-	void throw_if_index_out_of_range(size_t index) const;
+	/**
+	 *  @brief Calls the function with the stored parameters, moving them into the function.
+	 *  @tparam FUNCTION The function to be called.
+	 *  @return The return value of returned by the call to the supplied function.
+	 *  @throw Throws a std::runtime_error if not all parameters have values stored
+	 *
+	 *  Every stored value is passed to \a function as an rvalue, so functions accepting parameters by value or by rvalue
+	 *  reference take over the stored values without copying them.
+	 *
+	 *  \note The map is cleared once \a function returns (or throws). If not all parameters have values stored
+	 *    the map is not modified.
+	 */
+	template <typename FUNCTION>
+	auto submit_and_consume(FUNCTION &&function) requires(
+			std::is_invocable_v<FUNCTION, std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &&...>);
+
+	/****************************************************************************/
+	/********************************* Defaults *********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Returns a view which reads every parameter from this map or, if it has no value stored, from \a defaults.
+	 *  @param defaults A map with the same parameters, its names are not used.
+	 *
+	 *  The view refers to both maps without copying any values, so both should outlive it.
+	 */
+	template <typename DEFAULTS_NAME_TABLE>
+	[[nodiscard]] ParameterMapWithDefaults<BasicParameterMap, BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...>>
+	with_defaults(const BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...> &defaults) const &noexcept;
+	template <typename DEFAULTS_NAME_TABLE>
+	void with_defaults(const BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...> &defaults) && = delete;
+
+	/**
+	 *  @brief Calls the function with the stored parameters, taking any parameter without a stored value from \a defaults.
+	 *  @param defaults A map with the same parameters, its names are not used.
+	 *  @return The return value of returned by the call to the supplied function.
+	 *  @throw Throws a std::runtime_error if a parameter has no value stored in either map.
+	 *
+	 *  Every argument is passed by reference to the value stored in either map, no values are copied.
+	 */
+	template <typename DEFAULTS_NAME_TABLE, typename FUNCTION>
+	auto submit_with_defaults(const BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...> &defaults,
+														FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
+
+	/****************************************************************************/
+	/********************************** Merge ***********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Takes over the values stored in \a other, a map with the same parameters (its names are not used).
+	 *  @tparam POLICY Whether values already stored in this map are kept or overwritten.
+	 *
+	 *  Only the values which are taken over are copied, or moved if \a other is an rvalue, in a single pass over the
+	 *  parameters without any lookups. Values moved from remain stored in \a other in a moved-from state.
+	 */
+	template <MergePolicy POLICY = MergePolicy::overwrite, typename OTHER>
+	void merge_from(OTHER &&other) requires(detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>);
+
+	/**
+	 *  @brief Takes over the values stored in \a other for the parameters which have no value stored in this map.
+	 *
+	 *  Equivalent to merge_from<MergePolicy::keep_existing>(other).
+	 */
+	template <typename OTHER>
+	void fill_missing_from(OTHER &&other) requires(
+			detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>);
+
+	/**
+	 *  @brief Takes over all values stored in \a other, overwriting the values stored in this map.
+	 *
+	 *  Equivalent to merge_from<MergePolicy::overwrite>(other).
+	 */
+	template <typename OTHER>
+	void overwrite_with(OTHER &&other) requires(
+			detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>);
+
+	/****************************************************************************/
+	/******************************* Non-throwing *******************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Resolves the parameter identified by \a name into a key.
+	 *  @return The key, or ParameterError::unknown_name.
+	 */
+	[[nodiscard]] Expected<key_type> try_key(const std::string_view &name) const noexcept;
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a name, reporting failures instead of throwing.
+	 *  @return Nothing, or ParameterError::unknown_name or ParameterError::incompatible_type.
+	 *
+	 *  Exceptions thrown while assigning the value are propagated.
+	 */
+	template <typename T>
+	Expected<void> try_set(const std::string_view &name, T &&value);
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a index, reporting failures instead of throwing.
+	 *  @return Nothing, or ParameterError::index_out_of_range or ParameterError::incompatible_type.
+	 *
+	 *  Exceptions thrown while assigning the value are propagated.
+	 */
+	template <typename T>
+	Expected<void> try_set(size_t index, T &&value);
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a key, reporting failures instead of throwing.
+	 *  @return Nothing, or ParameterError::incompatible_type.
+	 *
+	 *  Exceptions thrown while assigning the value are propagated.
+	 */
+	template <typename T>
+	Expected<void> try_set(key_type key, T &&value);
+
+	/**
+	 *  @brief Gets the value of the parameter identified by \a name, reporting failures instead of throwing.
+	 *  @return A const reference to the value, or ParameterError::unknown_name, ParameterError::incompatible_type or
+	 *    ParameterError::no_value_stored.
+	 */
+	template <typename T>
+	[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &> try_get(
+			const std::string_view &name) const noexcept;
+
+	/**
+	 *  @brief Gets the value of the parameter identified by \a index, reporting failures instead of throwing.
+	 *  @return A const reference to the value, or ParameterError::index_out_of_range,
+	 *    ParameterError::incompatible_type or ParameterError::no_value_stored.
+	 */
+	template <typename T>
+	[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &> try_get(size_t index) const noexcept;
+
+	/**
+	 *  @brief Gets the value of the parameter identified by \a key, reporting failures instead of throwing.
+	 *  @return A const reference to the value, or ParameterError::incompatible_type or ParameterError::no_value_stored.
+	 */
+	template <typename T>
+	[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &> try_get(key_type key) const noexcept;
+
+	/**
+	 *  @brief Calls the function with the stored parameters, reporting missing values instead of throwing.
+	 *  @return The return value of the call, or ParameterError::no_value_stored if the function was not called.
+	 *
+	 *  Exceptions thrown by \a function are propagated.
+	 */
+	template <typename FUNCTION>
+	auto try_submit(FUNCTION &&function) const &requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
+
+private:
+	static constexpr size_t n_parameters = sizeof...(PARAMETERS);
+	static_assert(NAME_TABLE::n_names == n_parameters, "Exactly one name should be supplied per parameter");
+	using parameter_storage_t = detail::ParameterStorage<std::remove_cv_t<std::remove_reference_t<PARAMETERS>>...>;
+	parameter_storage_t m_stored_values;
+
+	void throw_if_index_out_of_range(size_t index) const;
 
 	template <size_t INDEX>
 	void throw_if_no_value_stored_for_index() const;
 
+	void throw_if_not_all_values_stored() const;
+
+	template <typename, typename...>
+	friend class BasicParameterMap;
+
+	template <typename, typename>
+	friend class ParameterMapWithDefaults;
+
+	template <size_t INDEX>
+	const auto *stored_value() const noexcept;
+
+	template <typename DEFAULTS, typename FUNCTION, size_t... I>
+	auto submit_with_defaults(const DEFAULTS &defaults, FUNCTION &&function, std::index_sequence<I...>) const;
+
+	struct ClearOnExit;
+
 	struct TruePredicate;
 
 	template <size_t INDEX>
@@ -231,10 +945,17 @@ private:
 	template <typename TYPE>
 	struct IsGettableAs;
 
-	template <class CT_PREDICATE, typename RT_PREDICATE, typename FUNCTION>
-	void pass_first_index_matching_predicate_to(const RT_PREDICATE &runtime_predicate, const FUNCTION &&func) const;
+	template <typename... ARGS>
+	struct IsConstructibleFrom;
+
+	template <class CT_PREDICATE, typename FUNCTION>
+	void pass_index_to(size_t index, const FUNCTION &&func) const;
 
-	auto ensure_name_matches(const std::string_view &name) const;
+	template <class CT_PREDICATE, typename FUNCTION>
+	bool try_pass_index_to(size_t index, const FUNCTION &&func) const;
+
+	template <typename T>
+	Expected<const std::remove_cv_t<std::remove_reference_t<T>> &> try_get_at(size_t index) const noexcept;
 };
 
 
@@ -243,203 +964,1214 @@ private:
 //////////////////    Implementation    /////////////////////
 /////////////////////////////////////////////////////////////
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename... PARAM_NAMES>
-ParameterMap<PARAMETERS...>::ParameterMap(PARAM_NAMES &&... names) requires(sizeof...(PARAMETERS) ==
-																																						sizeof...(PARAM_NAMES))
-		: m_parameter_name_hashes{std::hash<std::string>{}(std::forward<PARAM_NAMES>(names))...} {}
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::BasicParameterMap(PARAM_NAMES &&... names) requires(
+		(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+		std::is_constructible_v<NAME_TABLE, PARAM_NAMES...>)
+		: NAME_TABLE(std::forward<PARAM_NAMES>(names)...) {}
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... PARAM_NAMES>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::BasicParameterMap(LiteralNames tag, PARAM_NAMES &&... names) requires(
+		(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+		std::is_constructible_v<NAME_TABLE, LiteralNames, PARAM_NAMES...>)
+		: NAME_TABLE(tag, std::forward<PARAM_NAMES>(names)...) {}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t N>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::BasicParameterMap(const ParameterSchema<N> &schema) noexcept requires(
+		std::is_constructible_v<NAME_TABLE, const ParameterSchema<N> &>)
+		: NAME_TABLE(schema) {}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] typename BasicParameterMap<NAME_TABLE, PARAMETERS...>::key_type
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::key(const std::string_view &name) const {
+	const size_t index = NAME_TABLE::index_of(name);
+	if (index >= n_parameters) {
+		throw std::invalid_argument("No parameters match the given input");
+	}
+	return key_type{index};
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] std::string_view BasicParameterMap<NAME_TABLE, PARAMETERS...>::name(size_t index) const {
+	throw_if_index_out_of_range(index);
+	return NAME_TABLE::name(index);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] std::uint64_t BasicParameterMap<NAME_TABLE, PARAMETERS...>::schema_fingerprint() const noexcept {
+	if constexpr (detail::has_compile_time_names_v<NAME_TABLE>) {
+		return fingerprint;
+	} else {
+		std::uint64_t ret = fingerprint;
+		for (size_t i = 0; i < n_parameters; ++i) {
+			ret = detail::combine_hashes(ret, detail::hash_name(NAME_TABLE::name(i)));
+		}
+		return ret;
+	}
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename T>
-void ParameterMap<PARAMETERS...>::set(const std::string_view &name, T &&value) {
-	pass_first_index_matching_predicate_to<IsSettableFrom<T>>(ensure_name_matches(name),
-																														[&](auto i) { set<i.value>(value); });
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::set(const std::string_view &name, T &&value) {
+	pass_index_to<IsSettableFrom<T>>(NAME_TABLE::index_of(name), [&](auto i) { set<i.value>(std::forward<T>(value)); });
 }
 
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename T>
-void ParameterMap<PARAMETERS...>::set(size_t index, T &&value) {
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::set(size_t index, T &&value) {
 	throw_if_index_out_of_range(index);
-	pass_first_index_matching_predicate_to<IsSettableFrom<T>>([&](auto i) { return i == index; },
-																														[&](auto i) { set<i.value>(value); });
+	pass_index_to<IsSettableFrom<T>>(index, [&](auto i) { set<i.value>(std::forward<T>(value)); });
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::set(key_type key, T &&value) {
+	pass_index_to<IsSettableFrom<T>>(key.index(), [&](auto i) { set<i.value>(std::forward<T>(value)); });
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <size_t INDEX, typename T>
-void ParameterMap<PARAMETERS...>::set(T &&value) {
-	std::get<INDEX>(m_stored_values) = std::forward<T>(value);
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::set(T &&value) {
+	m_stored_values.template assign<INDEX>(std::forward<T>(value));
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... ARGS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::emplace(const std::string_view &name, ARGS &&... args) {
+	pass_index_to<IsConstructibleFrom<ARGS...>>(NAME_TABLE::index_of(name),
+																							[&](auto i) { emplace<i.value>(std::forward<ARGS>(args)...); });
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... ARGS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::emplace(size_t index, ARGS &&... args) {
+	throw_if_index_out_of_range(index);
+	pass_index_to<IsConstructibleFrom<ARGS...>>(index, [&](auto i) { emplace<i.value>(std::forward<ARGS>(args)...); });
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... ARGS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::emplace(key_type key, ARGS &&... args) {
+	pass_index_to<IsConstructibleFrom<ARGS...>>(key.index(),
+																							[&](auto i) { emplace<i.value>(std::forward<ARGS>(args)...); });
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX, typename... ARGS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::emplace(ARGS &&... args) requires(INDEX < sizeof...(PARAMETERS)) {
+	m_stored_values.template emplace<INDEX>(std::forward<ARGS>(args)...);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename T>
-[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &ParameterMap<PARAMETERS...>::get(
+[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &BasicParameterMap<NAME_TABLE, PARAMETERS...>::get(
 		const std::string_view &name) const {
-	const std::optional<std::remove_cv_t<std::remove_reference_t<T>>> *ret = nullptr;
-	pass_first_index_matching_predicate_to<IsGettableAs<T>>(ensure_name_matches(name), [&](auto i) {
+	const std::remove_cv_t<std::remove_reference_t<T>> *ret = nullptr;
+	pass_index_to<IsGettableAs<T>>(NAME_TABLE::index_of(name), [&](auto i) {
 		throw_if_no_value_stored_for_index<i.value>();
-		ret = &(std::get<i.value>(m_stored_values));
+		ret = &detail::unwrap_borrowed(m_stored_values.template value<i.value>());
 	});
-	return ret->value();
+	return *ret;
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename T>
-[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &ParameterMap<PARAMETERS...>::get(size_t index) const {
+[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &BasicParameterMap<NAME_TABLE, PARAMETERS...>::get(size_t index) const {
 	throw_if_index_out_of_range(index);
-	const std::optional<std::remove_cv_t<std::remove_reference_t<T>>> *ret = nullptr;
-	pass_first_index_matching_predicate_to<IsGettableAs<T>>([&](auto i) { return i == index; },
-																													[&](auto i) {
-																														throw_if_no_value_stored_for_index<i.value>();
-																														ret = &(std::get<i.value>(m_stored_values));
-																													});
-	return ret->value();
+	const std::remove_cv_t<std::remove_reference_t<T>> *ret = nullptr;
+	pass_index_to<IsGettableAs<T>>(index, [&](auto i) {
+		throw_if_no_value_stored_for_index<i.value>();
+		ret = &detail::unwrap_borrowed(m_stored_values.template value<i.value>());
+	});
+	return *ret;
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &BasicParameterMap<NAME_TABLE, PARAMETERS...>::get(
+		key_type key) const {
+	const std::remove_cv_t<std::remove_reference_t<T>> *ret = nullptr;
+	pass_index_to<IsGettableAs<T>>(key.index(), [&](auto i) {
+		throw_if_no_value_stored_for_index<i.value>();
+		ret = &detail::unwrap_borrowed(m_stored_values.template value<i.value>());
+	});
+	return *ret;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <size_t INDEX>
-[[nodiscard]] auto ParameterMap<PARAMETERS...>::get() const requires(INDEX < sizeof...(PARAMETERS)) {
+[[nodiscard]] decltype(auto) BasicParameterMap<NAME_TABLE, PARAMETERS...>::get() const
+		requires(INDEX < sizeof...(PARAMETERS)) {
 	throw_if_no_value_stored_for_index<INDEX>();
-	return std::get<INDEX>(m_stored_values).value();
+	if constexpr (detail::is_borrowed_v<BaseTypeAt_t<INDEX>>) {
+		return m_stored_values.template value<INDEX>().get();
+	} else {
+		return BaseTypeAt_t<INDEX>(m_stored_values.template value<INDEX>());
+	}
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <size_t INDEX>
-[[nodiscard]] bool ParameterMap<PARAMETERS...>::is_set() const noexcept requires(INDEX < sizeof...(PARAMETERS)) {
-	return std::get<INDEX>(m_stored_values).has_value();
+[[nodiscard]] bool BasicParameterMap<NAME_TABLE, PARAMETERS...>::is_set() const noexcept requires(INDEX < sizeof...(PARAMETERS)) {
+	return m_stored_values.template has_value<INDEX>();
 }
 
-template <typename... Parameters>
-[[nodiscard]] bool ParameterMap<Parameters...>::is_set(const std::string_view &name) {
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] bool BasicParameterMap<NAME_TABLE, PARAMETERS...>::is_set(const std::string_view &name) const {
 	bool ret = false;
-	pass_first_index_matching_predicate_to<TruePredicate>(ensure_name_matches(name),
-																												[&](auto i) { ret = is_set<i.value>(); });
+	pass_index_to<TruePredicate>(NAME_TABLE::index_of(name), [&](auto i) { ret = is_set<i.value>(); });
 	return ret;
 }
 
-template <typename... Parameters>
-[[nodiscard]] bool ParameterMap<Parameters...>::is_set(size_t index) {
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] bool BasicParameterMap<NAME_TABLE, PARAMETERS...>::is_set(size_t index) const {
 	bool ret = false;
-	pass_first_index_matching_predicate_to<TruePredicate>([&](auto i) { return i == index; },
-																												[&](auto i) { ret = is_set<i.value>(); });
+	pass_index_to<TruePredicate>(index, [&](auto i) { ret = is_set<i.value>(); });
 	return ret;
 }
 
-template <typename... PARAMETERS>
-void ParameterMap<PARAMETERS...>::clear() noexcept {
-	detail::static_for<0, n_parameters>([&](auto i) { std::get<i.value>(m_stored_values).reset(); });
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] bool BasicParameterMap<NAME_TABLE, PARAMETERS...>::is_set(key_type key) const noexcept {
+	bool ret = false;
+	pass_index_to<TruePredicate>(key.index(), [&](auto i) { ret = is_set<i.value>(); });
+	return ret;
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::clear() noexcept {
+	m_stored_values.clear();
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename FUNCTION>
-auto ParameterMap<PARAMETERS...>::submit(FUNCTION &&function) const
-		requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
-	detail::static_for<0, n_parameters>([&](auto i) {
-		if (!is_set<i.value>()) {
-			throw std::runtime_error("Unable to call function: No stored value for parameter");
-		}
-	});
-	return detail::apply_optionals(function, m_stored_values);
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::submit(FUNCTION &&function) const
+		&requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
+	throw_if_not_all_values_stored();
+	return m_stored_values.apply(function);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename FUNCTION>
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::submit(FUNCTION &&function) && requires(
+		std::is_invocable_v<FUNCTION, std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &&...>) {
+	return submit_and_consume(std::forward<FUNCTION>(function));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename FUNCTION>
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::submit_and_consume(FUNCTION &&function) requires(
+		std::is_invocable_v<FUNCTION, std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &&...>) {
+	throw_if_not_all_values_stored();
+	ClearOnExit clear_on_exit{*this};
+	return std::move(m_stored_values).apply(std::forward<FUNCTION>(function));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename DEFAULTS_NAME_TABLE>
+[[nodiscard]] ParameterMapWithDefaults<BasicParameterMap<NAME_TABLE, PARAMETERS...>,
+																			 BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...>>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::with_defaults(
+		const BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...> &defaults) const &noexcept {
+	return ParameterMapWithDefaults<BasicParameterMap, BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...>>(*this,
+																																																	defaults);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename DEFAULTS_NAME_TABLE, typename FUNCTION>
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::submit_with_defaults(
+		const BasicParameterMap<DEFAULTS_NAME_TABLE, PARAMETERS...> &defaults,
+		FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
+	return submit_with_defaults(defaults, std::forward<FUNCTION>(function), std::index_sequence_for<PARAMETERS...>{});
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <MergePolicy POLICY, typename OTHER>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::merge_from(OTHER &&other) requires(
+		detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>) {
+	if (static_cast<const void *>(&other) != static_cast<const void *>(this)) {
+		m_stored_values.template merge_from<POLICY == MergePolicy::overwrite>(
+				std::forward<OTHER>(other).m_stored_values);
+	}
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename OTHER>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::fill_missing_from(OTHER &&other) requires(
+		detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>) {
+	merge_from<MergePolicy::keep_existing>(std::forward<OTHER>(other));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename OTHER>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::overwrite_with(OTHER &&other) requires(
+		detail::is_map_with_parameters_v<std::remove_reference_t<OTHER>, PARAMETERS...>) {
+	merge_from<MergePolicy::overwrite>(std::forward<OTHER>(other));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] Expected<typename BasicParameterMap<NAME_TABLE, PARAMETERS...>::key_type>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_key(const std::string_view &name) const noexcept {
+	const size_t index = NAME_TABLE::index_of(name);
+	if (index >= n_parameters) {
+		return ParameterError::unknown_name;
+	}
+	return key_type{index};
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+Expected<void> BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_set(const std::string_view &name, T &&value) {
+	const size_t index = NAME_TABLE::index_of(name);
+	if (index >= n_parameters) {
+		return ParameterError::unknown_name;
+	}
+	return try_set(key_type{index}, std::forward<T>(value));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+Expected<void> BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_set(size_t index, T &&value) {
+	if (index >= n_parameters) {
+		return ParameterError::index_out_of_range;
+	}
+	return try_set(key_type{index}, std::forward<T>(value));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+Expected<void> BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_set(key_type key, T &&value) {
+	if (!try_pass_index_to<IsSettableFrom<T>>(key.index(), [&](auto i) { set<i.value>(std::forward<T>(value)); })) {
+		return ParameterError::incompatible_type;
+	}
+	return {};
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_get(const std::string_view &name) const noexcept {
+	const size_t index = NAME_TABLE::index_of(name);
+	if (index >= n_parameters) {
+		return ParameterError::unknown_name;
+	}
+	return try_get_at<T>(index);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_get(size_t index) const noexcept {
+	if (index >= n_parameters) {
+		return ParameterError::index_out_of_range;
+	}
+	return try_get_at<T>(index);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+[[nodiscard]] Expected<const std::remove_cv_t<std::remove_reference_t<T>> &>
+BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_get(key_type key) const noexcept {
+	return try_get_at<T>(key.index());
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename FUNCTION>
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_submit(FUNCTION &&function) const
+		&requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
+	using result_t =
+			std::invoke_result_t<FUNCTION &, const std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &...>;
+	if (!m_stored_values.all()) {
+		return Expected<result_t>{ParameterError::no_value_stored};
+	}
+	if constexpr (std::is_void_v<result_t>) {
+		m_stored_values.apply(function);
+		return Expected<result_t>{};
+	} else {
+		return Expected<result_t>{m_stored_values.apply(function)};
+	}
 }
 
 ////////////////////// Private Members //////////////////////
 
-template <typename... PARAMETERS>
-void ParameterMap<PARAMETERS...>::throw_if_index_out_of_range(size_t index) const {
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::throw_if_index_out_of_range(size_t index) const {
 	if (index >= n_parameters) {
 		throw std::out_of_range(std::string{"Index should be range [0 .. "} + std::to_string(n_parameters - 1) + "]");
 	}
 }
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <size_t INDEX>
-void ParameterMap<PARAMETERS...>::throw_if_no_value_stored_for_index() const {
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::throw_if_no_value_stored_for_index() const {
 	if (!is_set<INDEX>()) {
 		throw std::runtime_error("Parameter does not have a stored value");
 	}
 }
 
-template <typename... PARAMETERS>
-struct ParameterMap<PARAMETERS...>::TruePredicate {
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX>
+const auto *BasicParameterMap<NAME_TABLE, PARAMETERS...>::stored_value() const noexcept {
+	return is_set<INDEX>() ? &detail::unwrap_borrowed(m_stored_values.template value<INDEX>()) : nullptr;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename DEFAULTS, typename FUNCTION, size_t... I>
+auto BasicParameterMap<NAME_TABLE, PARAMETERS...>::submit_with_defaults(const DEFAULTS &defaults,
+																																				FUNCTION &&function,
+																																				std::index_sequence<I...>) const {
+	const std::tuple<const detail::borrowed_value_t<BaseTypeAt_t<I>> *...> values{
+			(is_set<I>() ? stored_value<I>() : defaults.template stored_value<I>())...};
+	if (((std::get<I>(values) == nullptr) || ...)) {
+		throw std::runtime_error("Unable to call function: No stored value or default for parameter");
+	}
+	return std::invoke(std::forward<FUNCTION>(function), *std::get<I>(values)...);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::throw_if_not_all_values_stored() const {
+	if (!m_stored_values.all()) {
+		throw std::runtime_error("Unable to call function: No stored value for parameter");
+	}
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::ClearOnExit {
+	BasicParameterMap &map;
+	~ClearOnExit() { map.clear(); }
+};
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::TruePredicate {
 	static constexpr auto value_for = [](auto) { return true; };
 };
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <size_t INDEX>
-struct ParameterMap<PARAMETERS...>::BaseTypeAt {
-	using type =
-			typename std::remove_cv_t<std::remove_reference_t<decltype(std::get<INDEX>(m_stored_values))>>::value_type;
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::BaseTypeAt {
+	using type = typename parameter_storage_t::template type_at<INDEX>;
 };
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename TYPE>
-struct ParameterMap<PARAMETERS...>::IsSettableFrom {
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::IsSettableFrom {
 	static constexpr auto value_for = [](auto index) {
-		return std::is_convertible_v<std::remove_cv_t<std::remove_reference_t<TYPE>>, BaseTypeAt_t<index.value>>;
+		if constexpr (detail::is_borrowed_v<BaseTypeAt_t<index.value>>) {
+			return std::is_constructible_v<BaseTypeAt_t<index.value>, TYPE>;
+		} else {
+			return std::is_convertible_v<std::remove_cv_t<std::remove_reference_t<TYPE>>, BaseTypeAt_t<index.value>>;
+		}
 	};
 };
 
-template <typename... PARAMETERS>
+template <typename NAME_TABLE, typename... PARAMETERS>
 template <typename TYPE>
-struct ParameterMap<PARAMETERS...>::IsGettableAs {
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::IsGettableAs {
 	static constexpr auto value_for = [](auto index) {
-		return std::is_same_v<std::remove_cv_t<std::remove_reference_t<TYPE>>, BaseTypeAt_t<index.value>>;
+		return std::is_same_v<std::remove_cv_t<std::remove_reference_t<TYPE>>,
+													detail::borrowed_value_t<BaseTypeAt_t<index.value>>>;
 	};
 };
 
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... ARGS>
+struct BasicParameterMap<NAME_TABLE, PARAMETERS...>::IsConstructibleFrom {
+	static constexpr auto value_for = [](auto index) {
+		return std::is_constructible_v<BaseTypeAt_t<index.value>, ARGS...>;
+	};
+};
 
-template <typename... PARAMETERS>
-template <class CT_PREDICATE, typename RT_PREDICATE, typename FUNCTION>
-void ParameterMap<PARAMETERS...>::pass_first_index_matching_predicate_to(const RT_PREDICATE &runtime_predicate,
-																																				 const FUNCTION &&func) const {
-	bool found = false;
 
-	detail::static_for<0, n_parameters>([&](auto i) {
-		if constexpr (CT_PREDICATE::value_for(i)) {
-			if (!found && runtime_predicate(static_cast<size_t>(i.value))) {
-				found = true;
-				func(i);
-			}
-		}
-	});
-	if (!found) {
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <class CT_PREDICATE, typename FUNCTION>
+void BasicParameterMap<NAME_TABLE, PARAMETERS...>::pass_index_to(size_t index, const FUNCTION &&func) const {
+	if (!try_pass_index_to<CT_PREDICATE>(index, std::move(func))) {
 		throw std::invalid_argument("No parameters match the given input");
 	}
 }
 
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <class CT_PREDICATE, typename FUNCTION>
+bool BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_pass_index_to(size_t index, const FUNCTION &&func) const {
+	bool matches = false;
+	detail::visit_index<n_parameters>(index, [&](auto i) {
+		if constexpr (CT_PREDICATE::value_for(i)) {
+			matches = true;
+			func(i);
+		}
+	});
+	return matches;
+}
 
-template <typename... PARAMETERS>
-auto ParameterMap<PARAMETERS...>::ensure_name_matches(const std::string_view &name) const {
-	auto name_hash = std::hash<std::string_view>{}(name);
-	return [&, name_hash](auto i) { return m_parameter_name_hashes.at(size_t(i)) == name_hash; };
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+Expected<const std::remove_cv_t<std::remove_reference_t<T>> &> BasicParameterMap<NAME_TABLE, PARAMETERS...>::try_get_at(
+		size_t index) const noexcept {
+	const std::remove_cv_t<std::remove_reference_t<T>> *ret = nullptr;
+	bool is_stored = false;
+	if (!try_pass_index_to<IsGettableAs<T>>(index, [&](auto i) {
+				is_stored = is_set<i.value>();
+				ret = &detail::unwrap_borrowed(m_stored_values.template value<i.value>());
+			})) {
+		return ParameterError::incompatible_type;
+	}
+	if (!is_stored) {
+		return ParameterError::no_value_stored;
+	}
+	return *ret;
 }
 
 
 /////////////////////////////////////////////////////////////
-//////////////////      Utilities       /////////////////////
+////////////////// ParameterMapWithDefaults /////////////////
 /////////////////////////////////////////////////////////////
 
-namespace detail {
-template <class F, class Tuple, std::size_t... I>
-constexpr decltype(auto) apply_optionals_impl(F &&f, Tuple &&t, std::index_sequence<I...>) {
-	return std::invoke(std::forward<F>(f), *std::get<I>(std::forward<Tuple>(t))...);
-}
+/**
+ *  @brief A read-only view of a parameter map which falls back to a second map for parameters without a stored value.
+ *
+ *  Obtained using \a with_defaults. Values are returned by reference to the map they are stored in, the view only
+ *  holds pointers to both maps.
+ */
+template <typename MAP, typename DEFAULTS>
+class ParameterMapWithDefaults {
+public:
+	ParameterMapWithDefaults(const MAP &map, const DEFAULTS &defaults) noexcept : m_map(&map), m_defaults(&defaults) {}
 
-template <class F, class Tuple>
-constexpr decltype(auto) apply_optionals(F &&f, Tuple &&t) {
-	return apply_optionals_impl(std::forward<F>(f),
-															std::forward<Tuple>(t),
-															std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<Tuple>>>{});
-}
+	/**
+	 *  @brief Returns the value of the parameter identified by \a name (using the names of the primary map).
+	 *  @throw std::invalid_argument if \a name or \a T do not match a parameter.
+	 *  @throw std::runtime_error if neither map has a value stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &get(const std::string_view &name) const {
+		return get<T>(m_map->key(name).index());
+	}
 
-template <int First, int Last, typename Lambda>
-inline void static_for(Lambda const &f) {
-	if constexpr (First < Last) {
-		f(std::integral_constant<int, First>{});
-		static_for<First + 1, Last>(f);
+	/**
+	 *  @brief Returns the value of the parameter identified by \a index.
+	 *  @throw std::out_of_range if \a index is out of range, std::invalid_argument if \a T does not match the parameter.
+	 *  @throw std::runtime_error if neither map has a value stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &get(size_t index) const {
+		const auto value = m_map->template try_get<T>(index);
+		if (value.has_value()) {
+			return *value;
+		}
+		if (value.error() != ParameterError::no_value_stored) {
+			return m_map->template get<T>(index);
+		}
+		return m_defaults->template get<T>(index);
 	}
-}
-}  // namespace detail
+
+	/**
+	 *  @brief Returns the value of the parameter at \a INDEX.
+	 *  @throw std::runtime_error if neither map has a value stored for the parameter.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] const auto &get() const {
+		if (const auto *value = m_map->template stored_value<INDEX>()) {
+			return *value;
+		}
+		if (const auto *value = m_defaults->template stored_value<INDEX>()) {
+			return *value;
+		}
+		throw std::runtime_error("Unable to get parameter: No stored value or default for parameter");
+	}
+
+	/**
+	 *  @brief Returns whether either map has a value stored for the parameter identified by \a name.
+	 */
+	[[nodiscard]] bool is_set(const std::string_view &name) const { return is_set(m_map->key(name).index()); }
+
+	/**
+	 *  @brief Returns whether either map has a value stored for the parameter identified by \a index.
+	 */
+	[[nodiscard]] bool is_set(size_t index) const { return m_map->is_set(index) || m_defaults->is_set(index); }
+
+	/**
+	 *  @brief Returns whether either map has a value stored for the parameter at \a INDEX.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] bool is_set() const noexcept {
+		return m_map->template is_set<INDEX>() || m_defaults->template is_set<INDEX>();
+	}
+
+	/**
+	 *  @brief Calls the function with the parameters of the view, see \a submit_with_defaults.
+	 */
+	template <typename FUNCTION>
+	auto submit(FUNCTION &&function) const {
+		return m_map->submit_with_defaults(*m_defaults, std::forward<FUNCTION>(function));
+	}
+
+private:
+	const MAP *m_map;
+	const DEFAULTS *m_defaults;
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////      Utilities       /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+template <int First, typename Lambda, int... I>
+inline void static_for_impl(Lambda const &f, std::integer_sequence<int, I...>) {
+	(f(std::integral_constant<int, First + I>{}), ...);
+}
+
+/**
+ *  @brief Calls \a f with std::integral_constant<int, i> for every i in [First, Last), in order.
+ *
+ *  Expands to a single fold expression, so the cost is one instantiation of \a f per index rather than a chain of
+ *  recursive static_for instantiations.
+ */
+template <int First, int Last, typename Lambda>
+inline void static_for(Lambda const &f) {
+	if constexpr (First < Last) {
+		static_for_impl<First>(f, std::make_integer_sequence<int, Last - First>{});
+	}
+}
+
+/**
+ *  @brief Entry \a INDEX of the jump table of \a visit_index.
+ */
+template <typename FUNCTION, size_t INDEX>
+void invoke_with_index(FUNCTION &func) {
+	func(std::integral_constant<size_t, INDEX>{});
+}
+
+template <typename FUNCTION, size_t... I>
+constexpr auto make_jump_table(std::index_sequence<I...>) {
+	return std::array<void (*)(FUNCTION &), sizeof...(I)>{&invoke_with_index<FUNCTION, I>...};
+}
+
+/**
+ *  @brief Calls \a func with std::integral_constant<size_t, index> using a jump table.
+ *  @throw std::invalid_argument if \a index is not smaller than \a N.
+ */
+template <size_t N, typename FUNCTION>
+void visit_index(size_t index, FUNCTION &&func) {
+	if (index >= N) {
+		throw std::invalid_argument("No parameters match the given input");
+	}
+	if constexpr (N > 0) {
+		using func_t = std::remove_reference_t<FUNCTION>;
+		static constexpr auto jump_table = make_jump_table<func_t>(std::make_index_sequence<N>{});
+		jump_table[index](func);
+	}
+}
+
+////////////////////////// Storage //////////////////////////
+
+/**
+ *  @brief Returns the index of the lowest set bit of a non-zero \a word.
+ */
+inline size_t count_trailing_zeros(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_ctzll(word));
+#else
+	size_t n = 0;
+	for (; (word & 1u) == 0; word >>= 1) {
+		++n;
+	}
+	return n;
+#endif
+}
+
+/**
+ *  @brief Forwards \a value like std::forward, but passes arrays (e.g. string literals) on as pointers.
+ *
+ *  Constructing a bool from an array reference compares the reference, which can not be null, to nullptr. GCC reports
+ *  that as -Wnonnull-compare once the placement new is inlined, while converting the decayed pointer is silent.
+ */
+template <typename T>
+constexpr decltype(auto) forward_decayed(std::remove_reference_t<T> &value) noexcept {
+	if constexpr (std::is_array_v<std::remove_reference_t<T>>) {
+		return static_cast<std::decay_t<T>>(value);
+	} else {
+		return static_cast<T &&>(value);
+	}
+}
+
+/**
+ *  @brief Uninitialized storage for a single \a T.
+ *
+ *  The constructor is user provided so that value initialization, as done by std::tuple, leaves the bytes
+ *  uninitialized rather than zero filling them.
+ */
+template <typename T>
+struct Slot {
+	Slot() noexcept {}
+
+	alignas(T) unsigned char bytes[sizeof(T)];
+};
+
+/**
+ *  @brief A packed set of N presence bits, stored in as few (and as small) words as possible.
+ */
+template <size_t N>
+class PresenceMask {
+public:
+	using word_t = std::conditional_t<
+			(N <= 8),
+			std::uint8_t,
+			std::conditional_t<(N <= 16), std::uint16_t, std::conditional_t<(N <= 32), std::uint32_t, std::uint64_t>>>;
+	static constexpr size_t bits_per_word = sizeof(word_t) * 8;
+	static constexpr size_t n_words = (N + bits_per_word - 1) / bits_per_word;
+
+	constexpr bool test(size_t i) const noexcept { return (m_words[i / bits_per_word] >> (i % bits_per_word)) & 1u; }
+	constexpr void set(size_t i) noexcept { m_words[i / bits_per_word] |= word_t(word_t{1} << (i % bits_per_word)); }
+	constexpr void reset(size_t i) noexcept { m_words[i / bits_per_word] &= word_t(~(word_t{1} << (i % bits_per_word))); }
+	constexpr void clear() noexcept { m_words = {}; }
+
+	/**
+	 *  @brief Returns whether all N bits are set, using a single comparison per word.
+	 */
+	constexpr bool all() const noexcept {
+		for (size_t w = 0; w < n_words; ++w) {
+			if (m_words[w] != full_word(w)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr bool none() const noexcept {
+		for (size_t w = 0; w < n_words; ++w) {
+			if (m_words[w] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr bool operator==(const PresenceMask &other) const noexcept { return m_words == other.m_words; }
+	constexpr bool operator!=(const PresenceMask &other) const noexcept { return m_words != other.m_words; }
+
+private:
+	std::array<word_t, n_words> m_words{};
+
+	static constexpr word_t full_word(size_t w) noexcept {
+		const size_t n_bits = (w + 1 < n_words || N % bits_per_word == 0) ? bits_per_word : N % bits_per_word;
+		return n_bits == bits_per_word ? word_t(~word_t{0}) : word_t((word_t{1} << n_bits) - 1);
+	}
+};
+
+/**
+ *  @brief Stores an optional value for each of \a TYPES in uninitialized storage, tracking presence in a PresenceMask.
+ *
+ *  Compared to a tuple of std::optional this avoids a bool (plus padding) per value, checks whether all values are
+ *  present with a single comparison per mask word and skips the destructor calls for trivially destructible types.
+ */
+template <typename... TYPES>
+class ParameterStorage {
+public:
+	static constexpr size_t n_values = sizeof...(TYPES);
+	template <size_t INDEX>
+	using type_at = std::tuple_element_t<INDEX, std::tuple<TYPES...>>;
+
+	ParameterStorage() noexcept = default;
+	ParameterStorage(const ParameterStorage &other) { construct_from(other); }
+	ParameterStorage(ParameterStorage &&other) noexcept((std::is_nothrow_move_constructible_v<TYPES> && ...)) {
+		construct_from(std::move(other));
+	}
+	ParameterStorage &operator=(const ParameterStorage &other) {
+		if (this != &other) {
+			assign_from(other);
+		}
+		return *this;
+	}
+	ParameterStorage &operator=(ParameterStorage &&other) noexcept(
+			((std::is_nothrow_move_constructible_v<TYPES> && std::is_nothrow_move_assignable_v<TYPES>)&&...)) {
+		if (this != &other) {
+			assign_from(std::move(other));
+		}
+		return *this;
+	}
+	~ParameterStorage() { clear(); }
+
+	template <size_t INDEX>
+	bool has_value() const noexcept {
+		return m_presence.test(INDEX);
+	}
+	bool all() const noexcept { return m_presence.all(); }
+	const PresenceMask<n_values> &presence() const noexcept { return m_presence; }
+
+	template <size_t INDEX>
+	type_at<INDEX> &value() &noexcept {
+		return *std::launder(reinterpret_cast<type_at<INDEX> *>(std::get<INDEX>(m_slots).bytes));
+	}
+	template <size_t INDEX>
+	const type_at<INDEX> &value() const &noexcept {
+		return *std::launder(reinterpret_cast<const type_at<INDEX> *>(std::get<INDEX>(m_slots).bytes));
+	}
+	template <size_t INDEX>
+	type_at<INDEX> &&value() &&noexcept {
+		return std::move(value<INDEX>());
+	}
+
+	/**
+	 *  @brief Assigns \a value to a present value or constructs it from \a value otherwise.
+	 */
+	template <size_t INDEX, typename T>
+	void assign(T &&value) {
+		if (has_value<INDEX>()) {
+			this->value<INDEX>() = forward_decayed<T>(value);
+		} else {
+			emplace<INDEX>(forward_decayed<T>(value));
+		}
+	}
+
+	/**
+	 *  @brief Assigns the values present in \a other which are missing here or, if \a OVERWRITE, all of them.
+	 */
+	template <bool OVERWRITE, typename OTHER>
+	void merge_from(OTHER &&other) {
+		if (other.m_presence.none() || (!OVERWRITE && m_presence.all())) {
+			return;
+		}
+		static_for<0, n_values>([&](auto i) {
+			if (other.template has_value<i.value>() && (OVERWRITE || !has_value<i.value>())) {
+				assign<i.value>(std::forward<OTHER>(other).template value<i.value>());
+			}
+		});
+	}
+
+	/**
+	 *  @brief Destroys a present value and constructs a new one from \a args.
+	 */
+	template <size_t INDEX, typename... ARGS>
+	void emplace(ARGS &&... args) {
+		reset<INDEX>();
+		::new (static_cast<void *>(std::get<INDEX>(m_slots).bytes)) type_at<INDEX>(forward_decayed<ARGS>(args)...);
+		m_presence.set(INDEX);
+	}
+
+	template <size_t INDEX>
+	void reset() noexcept {
+		if (has_value<INDEX>()) {
+			destroy<INDEX>();
+			m_presence.reset(INDEX);
+		}
+	}
+
+	void clear() noexcept {
+		if constexpr (!(std::is_trivially_destructible_v<TYPES> && ...)) {
+			static_for<0, n_values>([&](auto i) {
+				if (has_value<i.value>()) {
+					destroy<i.value>();
+				}
+			});
+		}
+		m_presence.clear();
+	}
+
+	/**
+	 *  @brief Calls \a function with all values, which should all be present.
+	 */
+	template <typename FUNCTION>
+	decltype(auto) apply(FUNCTION &&function) const & {
+		return apply_impl(*this, std::forward<FUNCTION>(function), std::index_sequence_for<TYPES...>{});
+	}
+	template <typename FUNCTION>
+	decltype(auto) apply(FUNCTION &&function) && {
+		return apply_impl(std::move(*this), std::forward<FUNCTION>(function), std::index_sequence_for<TYPES...>{});
+	}
+
+private:
+	std::tuple<Slot<TYPES>...> m_slots;
+	PresenceMask<n_values> m_presence;
+
+	template <size_t INDEX>
+	void destroy() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<type_at<INDEX>>) {
+			value<INDEX>().~type_at<INDEX>();
+		}
+	}
+
+	/**
+	 *  @brief Constructs the values present in \a other. If one of them throws, the values constructed before it are
+	 *    destroyed, as no destructor runs for a partially constructed storage.
+	 */
+	template <typename OTHER>
+	void construct_from(OTHER &&other) {
+		try {
+			static_for<0, n_values>([&](auto i) {
+				if (other.template has_value<i.value>()) {
+					emplace<i.value>(std::forward<OTHER>(other).template value<i.value>());
+				}
+			});
+		} catch (...) {
+			clear();
+			throw;
+		}
+	}
+
+	template <typename OTHER>
+	void assign_from(OTHER &&other) {
+		static_for<0, n_values>([&](auto i) {
+			if (other.template has_value<i.value>()) {
+				assign<i.value>(std::forward<OTHER>(other).template value<i.value>());
+			} else {
+				reset<i.value>();
+			}
+		});
+	}
+
+	template <typename SELF, typename FUNCTION, size_t... I>
+	static decltype(auto) apply_impl(SELF &&self, FUNCTION &&function, std::index_sequence<I...>) {
+		return std::invoke(std::forward<FUNCTION>(function), std::forward<SELF>(self).template value<I>()...);
+	}
+};
+
+/////////////////////////// Names ///////////////////////////
+
+/**
+ *  @brief 64 bit FNV-1a hash of \a name, usable at compile time.
+ */
+constexpr std::uint64_t hash_name(std::string_view name) noexcept {
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+	for (char c : name) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+/**
+ *  @brief Finalizer of MurmurHash3, used to derive slots from a name hash and a displacement.
+ */
+constexpr std::uint64_t mix_hash(std::uint64_t hash) noexcept {
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+constexpr size_t next_power_of_two(size_t n) noexcept {
+	size_t power = 1;
+	while (power < n) {
+		power *= 2;
+	}
+	return power;
+}
+
+/**
+ *  @brief Perfect hash table mapping N distinct names onto their index, built at compile time.
+ *
+ *  Uses hash-and-displace: names are grouped into buckets by their hash, after which a displacement is searched for
+ *  every bucket (largest first) which sends all names in the bucket to free slots. A lookup costs one hash of the
+ *  name, two table reads and a single string comparison to reject unknown names.
+ */
+template <size_t N>
+class PerfectHashTable {
+public:
+	constexpr explicit PerfectHashTable(const std::array<std::string_view, N> &names) : m_names(names) {
+		for (size_t i = 0; i < N; ++i) {
+			for (size_t j = 0; j < i; ++j) {
+				if (names[i] == names[j]) {
+					throw std::invalid_argument("Parameter names should be unique");
+				}
+			}
+		}
+		for (auto &slot : m_slots) {
+			slot = N;
+		}
+
+		std::array<size_t, n_buckets> bucket_sizes{};
+		for (size_t i = 0; i < N; ++i) {
+			++bucket_sizes[bucket_of(hash_name(names[i]))];
+		}
+		std::array<size_t, n_buckets> bucket_order{};
+		for (size_t b = 0; b < n_buckets; ++b) {
+			size_t pos = b;
+			for (; pos > 0 && bucket_sizes[bucket_order[pos - 1]] < bucket_sizes[b]; --pos) {
+				bucket_order[pos] = bucket_order[pos - 1];
+			}
+			bucket_order[pos] = b;
+		}
+
+		for (size_t bucket : bucket_order) {
+			if (bucket_sizes[bucket] == 0) {
+				break;
+			}
+			std::uint32_t displacement = 0;
+			while (!try_place(bucket, displacement)) {
+				if (++displacement == max_displacement) {
+					throw std::logic_error("Unable to construct a perfect hash table for the parameter names");
+				}
+			}
+			m_displacements[bucket] = displacement;
+		}
+	}
+
+	/**
+	 *  @brief Returns the index of \a name or N if \a name is not in the table.
+	 */
+	constexpr size_t find(std::string_view name) const noexcept {
+		if constexpr (N == 0) {
+			return N;
+		} else {
+			const auto hash = hash_name(name);
+			const size_t index = m_slots[slot_of(hash, m_displacements[bucket_of(hash)])];
+			return (index < N && m_names[index] == name) ? index : N;
+		}
+	}
+
+private:
+	static constexpr size_t n_buckets = next_power_of_two(N);
+	static constexpr size_t n_slots = next_power_of_two(2 * N);
+	static constexpr std::uint32_t max_displacement = 1u << 16;
+
+	std::array<std::string_view, N> m_names{};
+	std::array<std::uint32_t, n_buckets> m_displacements{};
+	std::array<size_t, n_slots> m_slots{};
+
+	static constexpr size_t bucket_of(std::uint64_t hash) noexcept { return (hash >> 32) & (n_buckets - 1); }
+	static constexpr size_t slot_of(std::uint64_t hash, std::uint32_t displacement) noexcept {
+		return mix_hash(hash ^ displacement) & (n_slots - 1);
+	}
+
+	constexpr bool try_place(size_t bucket, std::uint32_t displacement) {
+		size_t n_placed = 0;
+		for (size_t i = 0; i < N; ++i) {
+			const auto hash = hash_name(m_names[i]);
+			if (bucket_of(hash) != bucket) {
+				continue;
+			}
+			const size_t slot = slot_of(hash, displacement);
+			if (m_slots[slot] != N) {
+				unplace(bucket, displacement, n_placed);
+				return false;
+			}
+			m_slots[slot] = i;
+			++n_placed;
+		}
+		return true;
+	}
+
+	constexpr void unplace(size_t bucket, std::uint32_t displacement, size_t n_placed) {
+		for (size_t i = 0; i < N && n_placed > 0; ++i) {
+			const auto hash = hash_name(m_names[i]);
+			if (bucket_of(hash) == bucket) {
+				m_slots[slot_of(hash, displacement)] = N;
+				--n_placed;
+			}
+		}
+	}
+};
+
+/**
+ *  @brief Name table of a ParameterMap which receives its names at runtime.
+ *
+ *  Stores a hash and a view of every name. The viewed characters either live in one contiguous pool allocated at
+ *  construction (and shared by copies) or, when constructed with \a literal_names, are owned by the caller.
+ */
+template <size_t N>
+class RuntimeNames {
+public:
+	static constexpr size_t n_names = N;
+
+	/**
+	 *  @brief Copies the names into a single pool, which is shared with all copies of the table.
+	 */
+	template <typename... PARAM_NAMES>
+	explicit RuntimeNames(PARAM_NAMES &&... names) requires(
+			sizeof...(PARAM_NAMES) == N && (std::is_convertible_v<const PARAM_NAMES &, std::string_view> && ...))
+			: m_name_hashes{hash_name(names)...}, m_names{std::string_view(names)...} {
+		size_t pool_size = 0;
+		for (const auto &name : m_names) {
+			pool_size += name.size();
+		}
+		if (pool_size == 0) {
+			return;
+		}
+		std::shared_ptr<char[]> pool(new char[pool_size]);
+		size_t offset = 0;
+		for (auto &name : m_names) {
+			std::char_traits<char>::copy(pool.get() + offset, name.data(), name.size());
+			name = std::string_view(pool.get() + offset, name.size());
+			offset += name.size();
+		}
+		m_pool = std::move(pool);
+	}
+
+	/**
+	 *  @brief References the names, which must outlive the table and all of its copies.
+	 */
+	template <size_t... SIZES>
+	RuntimeNames(LiteralNames, const char (&... names)[SIZES]) noexcept requires(sizeof...(SIZES) == N)
+			: m_name_hashes{hash_name(names)...}, m_names{std::string_view(names)...} {}
+
+	// Moving copies, a moved-from table still refers to the pool.
+	RuntimeNames(const RuntimeNames &) = default;
+	RuntimeNames &operator=(const RuntimeNames &) = default;
+
+	/**
+	 *  @brief Returns the index of the first parameter matching \a name or N if there is none.
+	 *
+	 *  Only names whose hash matches are compared, so colliding hashes cannot alias two names.
+	 */
+	size_t index_of(const std::string_view &name) const noexcept {
+		const auto name_hash = hash_name(name);
+		for (size_t i = 0; i < N; ++i) {
+			if (m_name_hashes[i] == name_hash && m_names[i] == name) {
+				return i;
+			}
+		}
+		return N;
+	}
+
+	std::string_view name(size_t index) const noexcept { return m_names[index]; }
+
+private:
+	std::array<std::uint64_t, N> m_name_hashes;
+	std::array<std::string_view, N> m_names;
+	std::shared_ptr<const char[]> m_pool;
+};
+
+/**
+ *  @brief Name table of a ParameterMap with compile-time names: a perfect hash table shared by all instances.
+ */
+template <typename NAMES>
+class CompileTimeNames {
+public:
+	static constexpr size_t n_names = std::tuple_size_v<std::remove_cv_t<decltype(NAMES::value)>>;
+
+	static constexpr size_t index_of(const std::string_view &name) noexcept { return table.find(name); }
+
+	static constexpr std::string_view name(size_t index) noexcept { return NAMES::value[index]; }
+
+private:
+	static constexpr PerfectHashTable<n_names> table{NAMES::value};
+};
+
+/**
+ *  @brief Name table of a SchemaParameterMap: a pointer to a ParameterSchema.
+ */
+template <size_t N>
+class SchemaNames {
+public:
+	static constexpr size_t n_names = N;
+
+	explicit SchemaNames(const ParameterSchema<N> &schema) noexcept : m_schema(&schema) {}
+
+	size_t index_of(const std::string_view &name) const noexcept { return m_schema->index_of(name); }
+
+	std::string_view name(size_t index) const { return m_schema->name(index); }
+
+private:
+	const ParameterSchema<N> *m_schema;
+};
+
+/**
+ *  @brief Name table of a BoundParameterMap: refers to the ParameterSchema \a SCHEMA without any state.
+ */
+template <const auto &SCHEMA>
+class BoundSchemaNames {
+public:
+	static constexpr size_t n_names = std::remove_reference_t<decltype(SCHEMA)>::size();
+
+	static size_t index_of(const std::string_view &name) noexcept { return SCHEMA.index_of(name); }
+
+	static std::string_view name(size_t index) { return SCHEMA.name(index); }
+};
+
+//////////////////////// Fingerprint ////////////////////////
+
+/**
+ *  @brief Returns the signature of this function, which names \a T. Differs between compilers but not between runs.
+ */
+template <typename T>
+constexpr std::string_view type_signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return __FUNCSIG__;
+#else
+	return __PRETTY_FUNCTION__;
+#endif
+}
+
+constexpr std::uint64_t combine_hashes(std::uint64_t seed, std::uint64_t hash) noexcept {
+	return mix_hash(seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+template <typename T>
+constexpr std::uint64_t type_fingerprint() noexcept {
+	return combine_hashes(combine_hashes(hash_name(type_signature<T>()), sizeof(T)), alignof(T));
+}
+
+/**
+ *  @brief Computes BasicParameterMap::fingerprint from the stored types, the byte order of the machine and, if known at
+ *    compile time, the names.
+ */
+template <typename NAME_TABLE, typename... PARAMETERS>
+constexpr std::uint64_t fingerprint_of() noexcept {
+	constexpr std::uint32_t byte_order = 0x01020304;
+	std::uint64_t fingerprint = combine_hashes(hash_name("qbouts::ParameterMap"), byte_order);
+	((fingerprint =
+				combine_hashes(fingerprint, type_fingerprint<std::remove_cv_t<std::remove_reference_t<PARAMETERS>>>())),
+	 ...);
+	if constexpr (has_compile_time_names_v<NAME_TABLE>) {
+		for (size_t i = 0; i < NAME_TABLE::n_names; ++i) {
+			fingerprint = combine_hashes(fingerprint, hash_name(NAME_TABLE::name(i)));
+		}
+	}
+	return fingerprint;
+}
+}  // namespace detail
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   ParameterSchema    /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+template <size_t N>
+template <typename... NAMES>
+ParameterSchema<N>::ParameterSchema(const NAMES &... names) requires(
+		sizeof...(NAMES) == N && (std::is_convertible_v<NAMES, std::string_view> && ...))
+		: ParameterSchema(std::array<std::string_view, N>{std::string_view(names)...}) {}
+
+template <size_t N>
+ParameterSchema<N>::ParameterSchema(const std::array<std::string_view, N> &names)
+		: m_pool(std::make_unique<char[]>(std::accumulate(
+					names.begin(), names.end(), size_t{0}, [](size_t size, auto name) { return size + name.size(); }))),
+			m_names(copy_to_pool(names, m_pool.get())),
+			m_table(m_names) {}
+
+template <size_t N>
+[[nodiscard]] size_t ParameterSchema<N>::index_of(const std::string_view &name) const noexcept {
+	return m_table.find(name);
+}
+
+template <size_t N>
+[[nodiscard]] std::string_view ParameterSchema<N>::name(size_t index) const {
+	if (index >= N) {
+		throw std::out_of_range("Parameter index out of range");
+	}
+	return m_names[index];
+}
+
+////////////////////// Private Members //////////////////////
+
+template <size_t N>
+std::array<std::string_view, N> ParameterSchema<N>::copy_to_pool(const std::array<std::string_view, N> &names,
+																																	char *pool) {
+	std::array<std::string_view, N> ret;
+	for (size_t i = 0; i < N; ++i) {
+		std::char_traits<char>::copy(pool, names[i].data(), names[i].size());
+		ret[i] = std::string_view(pool, names[i].size());
+		pool += names[i].size();
+	}
+	return ret;
+}
 
 
 }  // namespace qbouts
@@ -0,0 +1,332 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef PARAMETER_MAP_HANDLE_H
+#define PARAMETER_MAP_HANDLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+namespace detail {
+class EpochRegistry;
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////
+//////////////////  ParameterMapHandle  /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief Shares an immutable snapshot of a parameter map, which can be replaced as a whole while it is being read.
+ *  @tparam MAP The map type being shared, e.g. ParameterMap<std::string, double>. Unlike ConcurrentParameterMap, its
+ *    parameters may be of any copyable type.
+ *
+ *  Readers access the current snapshot with \a read or \a submit, which never block and always see a complete
+ *  snapshot. \a update copies the current snapshot, lets a function modify the copy and publishes it with a single
+ *  atomic exchange (read-copy-update).
+ *
+ *  Replaced snapshots are reclaimed once no reader can still access them, using epochs: every thread reading a handle
+ *  announces the epoch in which its read started in a slot of its own, so reads do not modify any reference count
+ *  shared with other threads. Reclamation is deferred to later updates (or \a reclaim) and never waits for readers.
+ *
+ *  The handle must outlive all reads, and its destructor must not run concurrently with any other member function.
+ */
+template <typename MAP>
+class ParameterMapHandle {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param map The initial snapshot.
+	 */
+	explicit ParameterMapHandle(MAP map);
+	~ParameterMapHandle();
+
+	ParameterMapHandle(const ParameterMapHandle &) = delete;
+	ParameterMapHandle &operator=(const ParameterMapHandle &) = delete;
+
+	/**
+	 *  @brief Calls \a function with the current snapshot.
+	 *  @return The return value of the call.
+	 *
+	 *  The snapshot remains valid until \a function returns, even if it is replaced in the meantime. \a function may
+	 *  read the handle again, but should not update it.
+	 */
+	template <typename FUNCTION>
+	auto read(FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, const MAP &>);
+
+	/**
+	 *  @brief Submits the current snapshot to \a function, see BasicParameterMap::submit.
+	 */
+	template <typename FUNCTION>
+	auto submit(FUNCTION &&function) const;
+
+	/**
+	 *  @brief Calls \a function with a copy of the current snapshot and publishes the modified copy.
+	 *
+	 *  Updates are serialized. Readers see either the old or the new snapshot. Nothing is published if \a function
+	 *  throws.
+	 */
+	template <typename FUNCTION>
+	void update(FUNCTION &&function) requires(std::is_invocable_v<FUNCTION, MAP &>);
+
+	/**
+	 *  @brief Destroys the replaced snapshots which can no longer be read.
+	 *  @return The number of replaced snapshots which are still being read.
+	 */
+	size_t reclaim();
+
+private:
+	struct RetiredSnapshot {
+		const MAP *map;
+		std::uint64_t epoch;  // The epoch in which it was replaced.
+	};
+
+	/**
+	 *  @brief Destroys the retired snapshots which no reader can access anymore. The write mutex should be held.
+	 */
+	void reclaim_retired();
+
+	std::shared_ptr<detail::EpochRegistry> m_registry;
+	std::atomic<const MAP *> m_current;
+	std::mutex m_write_mutex;
+	std::vector<RetiredSnapshot> m_retired;
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////    Epoch registry    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief The epoch of a handle and the slots in which reading threads announce the epoch they started reading in.
+ *
+ *  Slots are claimed by a thread on its first read and returned when it exits. They are never freed before the
+ *  registry, which is kept alive by the handle and by every thread holding one of its slots.
+ */
+class EpochRegistry {
+public:
+	struct alignas(64) Slot {
+		std::atomic<std::uint64_t> epoch{0};  // 0 if the thread is not reading.
+		std::atomic<bool> in_use{true};
+		unsigned depth = 0;  // Number of nested reads, only accessed by the thread holding the slot.
+		Slot *next = nullptr;
+	};
+
+	EpochRegistry() = default;
+	EpochRegistry(const EpochRegistry &) = delete;
+	EpochRegistry &operator=(const EpochRegistry &) = delete;
+
+	~EpochRegistry() {
+		for (Slot *slot = m_slots.load(); slot != nullptr;) {
+			delete std::exchange(slot, slot->next);
+		}
+	}
+
+	/**
+	 *  @brief Advances the epoch, returning the epoch which ended.
+	 */
+	std::uint64_t advance() noexcept { return m_epoch.fetch_add(1); }
+
+	std::uint64_t epoch() const noexcept { return m_epoch.load(); }
+
+	/**
+	 *  @brief Returns the oldest epoch announced by any reading thread, or UINT64_MAX if none is reading.
+	 */
+	std::uint64_t oldest_announced_epoch() const noexcept {
+		std::uint64_t oldest = UINT64_MAX;
+		for (const Slot *slot = m_slots.load(); slot != nullptr; slot = slot->next) {
+			if (const std::uint64_t epoch = slot->epoch.load(); epoch != 0) {
+				oldest = std::min(oldest, epoch);
+			}
+		}
+		return oldest;
+	}
+
+	Slot *claim_slot() {
+		for (Slot *slot = m_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next) {
+			bool in_use = false;
+			if (!slot->in_use.load(std::memory_order_relaxed) && slot->in_use.compare_exchange_strong(in_use, true)) {
+				return slot;
+			}
+		}
+		auto *slot = new Slot;
+		slot->next = m_slots.load(std::memory_order_relaxed);
+		while (!m_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		return slot;
+	}
+
+	static void release_slot(Slot *slot) noexcept {
+		slot->epoch.store(0, std::memory_order_relaxed);
+		slot->depth = 0;
+		slot->in_use.store(false, std::memory_order_release);
+	}
+
+private:
+	std::atomic<std::uint64_t> m_epoch{1};
+	std::atomic<Slot *> m_slots{nullptr};
+};
+
+/**
+ *  @brief The slots held by the current thread, one for every registry it has read from.
+ */
+class ThreadEpochSlots {
+public:
+	struct Entry {
+		std::shared_ptr<EpochRegistry> registry;
+		EpochRegistry::Slot *slot;
+	};
+
+	ThreadEpochSlots() = default;
+	ThreadEpochSlots(const ThreadEpochSlots &) = delete;
+	ThreadEpochSlots &operator=(const ThreadEpochSlots &) = delete;
+
+	~ThreadEpochSlots() {
+		for (auto &entry : m_entries) {
+			EpochRegistry::release_slot(entry.slot);
+		}
+	}
+
+	/**
+	 *  @brief Returns the slot of the current thread in \a registry, claiming one on the first read.
+	 *
+	 *  The slot remains valid while \a registry exists, regardless of slots claimed or returned later.
+	 */
+	EpochRegistry::Slot *slot_for(const std::shared_ptr<EpochRegistry> &registry) {
+		for (const auto &entry : m_entries) {
+			if (entry.registry == registry) {
+				return entry.slot;
+			}
+		}
+		// Return the slots of registries whose handle has been destroyed before claiming a new one.
+		m_entries.erase(std::remove_if(m_entries.begin(),
+																	 m_entries.end(),
+																	 [](const Entry &entry) {
+																		 if (entry.registry.use_count() > 1 || entry.slot->depth > 0) {
+																			 return false;
+																		 }
+																		 EpochRegistry::release_slot(entry.slot);
+																		 return true;
+																	 }),
+										m_entries.end());
+		return m_entries.emplace_back(Entry{registry, registry->claim_slot()}).slot;
+	}
+
+	static ThreadEpochSlots &current() {
+		static thread_local ThreadEpochSlots slots;
+		return slots;
+	}
+
+private:
+	std::vector<Entry> m_entries;
+};
+
+/**
+ *  @brief Announces the current epoch for the lifetime of the guard, unless the thread is already reading.
+ */
+class EpochGuard {
+public:
+	explicit EpochGuard(const std::shared_ptr<EpochRegistry> &registry)
+			: m_slot(ThreadEpochSlots::current().slot_for(registry)) {
+		if (m_slot->depth++ == 0) {
+			m_slot->epoch.store(registry->epoch());
+		}
+	}
+
+	~EpochGuard() {
+		if (--m_slot->depth == 0) {
+			m_slot->epoch.store(0, std::memory_order_release);
+		}
+	}
+
+	EpochGuard(const EpochGuard &) = delete;
+	EpochGuard &operator=(const EpochGuard &) = delete;
+
+private:
+	EpochRegistry::Slot *m_slot;
+};
+}  // namespace detail
+
+
+/////////////////////////////////////////////////////////////
+//////////////////  ParameterMapHandle  /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+// The announcement of a reader, the load of the snapshot and the exchange, epoch advance and slot scans of a writer
+// are sequentially consistent. A reader announcing an epoch newer than the one in which a snapshot was replaced
+// therefore loads a newer snapshot, and a writer which sees no announcement of an older epoch may destroy it.
+
+template <typename MAP>
+ParameterMapHandle<MAP>::ParameterMapHandle(MAP map)
+		: m_registry(std::make_shared<detail::EpochRegistry>()), m_current(new MAP(std::move(map))) {}
+
+template <typename MAP>
+ParameterMapHandle<MAP>::~ParameterMapHandle() {
+	delete m_current.load();
+	for (const auto &retired : m_retired) {
+		delete retired.map;
+	}
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+auto ParameterMapHandle<MAP>::read(FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, const MAP &>) {
+	detail::EpochGuard guard(m_registry);
+	return std::invoke(std::forward<FUNCTION>(function), *m_current.load());
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+auto ParameterMapHandle<MAP>::submit(FUNCTION &&function) const {
+	return read([&](const MAP &map) { return map.submit(std::forward<FUNCTION>(function)); });
+}
+
+template <typename MAP>
+template <typename FUNCTION>
+void ParameterMapHandle<MAP>::update(FUNCTION &&function) requires(std::is_invocable_v<FUNCTION, MAP &>) {
+	std::lock_guard<std::mutex> lock(m_write_mutex);
+	auto next = std::make_unique<MAP>(*m_current.load());
+	std::invoke(std::forward<FUNCTION>(function), *next);
+	m_retired.reserve(m_retired.size() + 1);
+	const MAP *previous = m_current.exchange(next.release());
+	m_retired.push_back({previous, m_registry->advance()});
+	reclaim_retired();
+}
+
+template <typename MAP>
+size_t ParameterMapHandle<MAP>::reclaim() {
+	std::lock_guard<std::mutex> lock(m_write_mutex);
+	reclaim_retired();
+	return m_retired.size();
+}
+
+////////////////////// Private Members //////////////////////
+
+template <typename MAP>
+void ParameterMapHandle<MAP>::reclaim_retired() {
+	// A reader which announced an epoch after the one in which a snapshot was replaced can not have loaded it.
+	const std::uint64_t oldest_epoch = m_registry->oldest_announced_epoch();
+	const auto reclaimable = std::partition(m_retired.begin(), m_retired.end(), [&](const RetiredSnapshot &retired) {
+		return retired.epoch >= oldest_epoch;
+	});
+	std::for_each(reclaimable, m_retired.end(), [](const RetiredSnapshot &retired) { delete retired.map; });
+	m_retired.erase(reclaimable, m_retired.end());
+}
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,601 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef PARAMETER_TABLE_H
+#define PARAMETER_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+namespace detail {
+template <typename T>
+class Column;
+
+template <typename ITERATOR>
+constexpr bool is_forward_iterator_v =
+		std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ITERATOR>::iterator_category>;
+}  // namespace detail
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+class BasicParameterTable;
+
+/**
+ *  @brief A ParameterTable whose parameter names are supplied to the constructor at runtime.
+ */
+template <typename... PARAMETERS>
+using ParameterTable = BasicParameterTable<detail::RuntimeNames<sizeof...(PARAMETERS)>, PARAMETERS...>;
+
+/**
+ *  @brief A ParameterTable whose parameter names are fixed at compile time, see \a StaticParameterMap.
+ */
+template <typename NAMES, typename... PARAMETERS>
+using StaticParameterTable = BasicParameterTable<detail::CompileTimeNames<NAMES>, PARAMETERS...>;
+
+/////////////////////////////////////////////////////////////
+//////////////////    ParameterTable    /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief Stores many rows of named parameters column by column and submits every complete row to a function.
+ *
+ *  A parameter table can be thought of as a set of ParameterMaps with identical parameters, stored as a structure of
+ *  arrays: every parameter has a single contiguous column of values plus a bitmap recording for which rows a value
+ *  is stored. The names are stored once for the whole table.
+ *
+ *  \par Filling a ParameterTable
+ *  Values can be stored per row using \a set, identifying the parameter by name or index like a ParameterMap does.
+ *  Whole ranges of a column can be stored at once using \a fill, which copies trivially copyable values with a single
+ *  (vectorizable) copy.
+ *
+ *  \par Calling a function with the stored parameters
+ *  \a submit_all calls the supplied function once for every complete row, in row order. Rows which are missing one
+ *  or more values are skipped.
+ */
+template <typename NAME_TABLE, typename... PARAMETERS>
+class BasicParameterTable : private NAME_TABLE {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param names The names of the parameters represented by the table.
+	 *
+	 *  Constructs an empty table given a set of parameter names.
+	 *  Exactly one name should be supplied per parameter, compilation will fail otherwise.
+	 */
+	template <typename... PARAM_NAMES>
+	explicit BasicParameterTable(PARAM_NAMES &&... names) requires(
+			(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+			std::is_constructible_v<NAME_TABLE, PARAM_NAMES...>);
+
+	/****************************************************************************/
+	/*********************************** Rows ***********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Returns the number of rows in the table.
+	 */
+	[[nodiscard]] size_t rows() const noexcept { return m_rows; }
+
+	/**
+	 *  @brief Changes the number of rows to \a n_rows. Added rows are empty, values of removed rows are destroyed.
+	 */
+	void resize(size_t n_rows);
+
+	/**
+	 *  @brief Appends an empty row.
+	 *  @return The index of the new row.
+	 */
+	size_t add_row();
+
+	/**
+	 *  @brief Clears (destroys) all stored values, keeping the number of rows.
+	 */
+	void clear() noexcept;
+
+	/**
+	 *  @brief Returns the number of parameters in the table.
+	 */
+	static constexpr size_t size() noexcept { return n_parameters; }
+
+	/****************************************************************************/
+	/*********************************** Set ************************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a name for \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 *  @throw  std::invalid_argument if no parameters match @a name.
+	 */
+	template <typename T>
+	void set(size_t row, const std::string_view &name, T &&value);
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a index for \a row.
+	 *  @throw  std::out_of_range if @a row or @a index is invalid.
+	 *  @throw  std::invalid_argument if the parameter type is incompatible to @a value.
+	 */
+	template <typename T>
+	void set(size_t row, size_t index, T &&value);
+
+	/**
+	 *  @brief Sets the value of the parameter identified by \a INDEX for \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 */
+	template <size_t INDEX, typename T>
+	void set(size_t row, T &&value) requires(INDEX < sizeof...(PARAMETERS));
+
+	/**
+	 *  @brief Stores the values in [\a first, \a last) for the parameter \a INDEX, starting at \a first_row.
+	 *  @throw  std::out_of_range if the values do not fit in the table, no values are stored then.
+	 *
+	 *  The range is traversed twice, once to check its size, so \a ITERATOR should be a forward iterator.
+	 */
+	template <size_t INDEX, typename ITERATOR>
+	void fill(size_t first_row, ITERATOR first, ITERATOR last) requires(
+			INDEX < sizeof...(PARAMETERS) && detail::is_forward_iterator_v<ITERATOR>);
+
+	/**
+	 *  @brief Stores the values in [\a first, \a last) for the parameter \a name, starting at \a first_row.
+	 *  @throw  std::out_of_range if the values do not fit in the table.
+	 *  @throw  std::invalid_argument if no parameters match @a name.
+	 */
+	template <typename ITERATOR>
+	void fill(const std::string_view &name, size_t first_row, ITERATOR first, ITERATOR last) requires(
+			detail::is_forward_iterator_v<ITERATOR>);
+
+	/****************************************************************************/
+	/*********************************** Get ************************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Gets the value of the parameter identified by \a name for \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 *  @throw  std::invalid_argument if no parameters match @a name or if the parameter type is incompatible to @a T.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <typename T>
+	[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &get(size_t row, const std::string_view &name) const;
+
+	/**
+	 *  @brief Gets the value of the parameter identified by \a INDEX for \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 *  @throw  std::runtime_error if no value is stored for the parameter.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] const auto &get(size_t row) const requires(INDEX < sizeof...(PARAMETERS));
+
+	/**
+	 *  @brief Returns whether a value is set for the parameter identified by \a name in \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 *  @throw  std::invalid_argument if no parameters match @a name.
+	 */
+	[[nodiscard]] bool is_set(size_t row, const std::string_view &name) const;
+
+	/**
+	 *  @brief Returns whether a value is set for the parameter identified by \a INDEX in \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] bool is_set(size_t row) const requires(INDEX < sizeof...(PARAMETERS));
+
+	/**
+	 *  @brief Returns whether values are set for all parameters in \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 */
+	[[nodiscard]] bool is_complete(size_t row) const;
+
+	/****************************************************************************/
+	/********************************* submit ***********************************/
+	/****************************************************************************/
+
+	/**
+	 *  @brief Calls the function with the parameters stored in \a row.
+	 *  @throw  std::out_of_range if @a row is an invalid row.
+	 *  @throw  std::runtime_error if not all parameters have values stored in @a row.
+	 */
+	template <typename FUNCTION>
+	auto submit(size_t row, FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
+
+	/**
+	 *  @brief Calls the function with the parameters of every complete row, in row order.
+	 *  @return The return values of the calls in row order, or nothing if \a function returns void.
+	 *
+	 *  Complete rows are found by combining the presence bitmaps of all columns 64 rows at a time.
+	 */
+	template <typename FUNCTION>
+	auto submit_all(FUNCTION &&function) const requires(std::is_invocable_v<FUNCTION, PARAMETERS...>);
+
+private:
+	static constexpr size_t n_parameters = sizeof...(PARAMETERS);
+	static_assert(NAME_TABLE::n_names == n_parameters, "Exactly one name should be supplied per parameter");
+	using column_tuple_t = std::tuple<detail::Column<std::remove_cv_t<std::remove_reference_t<PARAMETERS>>>...>;
+	template <size_t INDEX>
+	using BaseTypeAt_t = std::tuple_element_t<INDEX, std::tuple<std::remove_cv_t<std::remove_reference_t<PARAMETERS>>...>>;
+
+	column_tuple_t m_columns;
+	size_t m_rows = 0;
+
+	void throw_if_row_out_of_range(size_t row) const;
+
+	template <size_t INDEX>
+	void throw_if_no_value_stored_for(size_t row) const;
+
+	std::vector<std::uint64_t> complete_rows() const;
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////    ParameterTable    /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename... PARAM_NAMES>
+BasicParameterTable<NAME_TABLE, PARAMETERS...>::BasicParameterTable(PARAM_NAMES &&... names) requires(
+		(std::is_convertible_v<PARAM_NAMES, std::string_view> && ...) &&
+		std::is_constructible_v<NAME_TABLE, PARAM_NAMES...>)
+		: NAME_TABLE(std::forward<PARAM_NAMES>(names)...) {}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::resize(size_t n_rows) {
+	std::apply([&](auto &... columns) { (columns.resize(n_rows), ...); }, m_columns);
+	m_rows = n_rows;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+size_t BasicParameterTable<NAME_TABLE, PARAMETERS...>::add_row() {
+	resize(m_rows + 1);
+	return m_rows - 1;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::clear() noexcept {
+	std::apply([&](auto &... columns) { (columns.clear(), ...); }, m_columns);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::set(size_t row, const std::string_view &name, T &&value) {
+	throw_if_row_out_of_range(row);
+	detail::visit_index<n_parameters>(NAME_TABLE::index_of(name), [&](auto i) {
+		if constexpr (std::is_convertible_v<std::remove_cv_t<std::remove_reference_t<T>>, BaseTypeAt_t<i.value>>) {
+			std::get<i.value>(m_columns).assign(row, std::forward<T>(value));
+		} else {
+			throw std::invalid_argument("No parameters match the given input");
+		}
+	});
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::set(size_t row, size_t index, T &&value) {
+	throw_if_row_out_of_range(row);
+	if (index >= n_parameters) {
+		throw std::out_of_range("Parameter index out of range");
+	}
+	detail::visit_index<n_parameters>(index, [&](auto i) {
+		if constexpr (std::is_convertible_v<std::remove_cv_t<std::remove_reference_t<T>>, BaseTypeAt_t<i.value>>) {
+			std::get<i.value>(m_columns).assign(row, std::forward<T>(value));
+		} else {
+			throw std::invalid_argument("No parameters match the given input");
+		}
+	});
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX, typename T>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::set(size_t row, T &&value) requires(INDEX < sizeof...(PARAMETERS)) {
+	throw_if_row_out_of_range(row);
+	std::get<INDEX>(m_columns).assign(row, std::forward<T>(value));
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX, typename ITERATOR>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::fill(size_t first_row, ITERATOR first, ITERATOR last) requires(
+		INDEX < sizeof...(PARAMETERS) && detail::is_forward_iterator_v<ITERATOR>) {
+	const auto n_values = static_cast<size_t>(std::distance(first, last));
+	if (first_row > m_rows || n_values > m_rows - first_row) {
+		throw std::out_of_range("Values do not fit in the table");
+	}
+	std::get<INDEX>(m_columns).fill(first_row, first, last);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename ITERATOR>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::fill(const std::string_view &name,
+																												 size_t first_row,
+																												 ITERATOR first,
+																												 ITERATOR last) requires(
+		detail::is_forward_iterator_v<ITERATOR>) {
+	detail::visit_index<n_parameters>(NAME_TABLE::index_of(name), [&](auto i) {
+		if constexpr (std::is_convertible_v<typename std::iterator_traits<ITERATOR>::value_type, BaseTypeAt_t<i.value>>) {
+			fill<i.value>(first_row, first, last);
+		} else {
+			throw std::invalid_argument("No parameters match the given input");
+		}
+	});
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename T>
+[[nodiscard]] const std::remove_cv_t<std::remove_reference_t<T>> &BasicParameterTable<NAME_TABLE, PARAMETERS...>::get(
+		size_t row, const std::string_view &name) const {
+	throw_if_row_out_of_range(row);
+	const std::remove_cv_t<std::remove_reference_t<T>> *ret = nullptr;
+	detail::visit_index<n_parameters>(NAME_TABLE::index_of(name), [&](auto i) {
+		if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, BaseTypeAt_t<i.value>>) {
+			throw_if_no_value_stored_for<i.value>(row);
+			ret = &std::get<i.value>(m_columns).value(row);
+		} else {
+			throw std::invalid_argument("No parameters match the given input");
+		}
+	});
+	return *ret;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX>
+[[nodiscard]] const auto &BasicParameterTable<NAME_TABLE, PARAMETERS...>::get(size_t row) const
+		requires(INDEX < sizeof...(PARAMETERS)) {
+	throw_if_row_out_of_range(row);
+	throw_if_no_value_stored_for<INDEX>(row);
+	return std::get<INDEX>(m_columns).value(row);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] bool BasicParameterTable<NAME_TABLE, PARAMETERS...>::is_set(size_t row,
+																																					const std::string_view &name) const {
+	throw_if_row_out_of_range(row);
+	bool ret = false;
+	detail::visit_index<n_parameters>(NAME_TABLE::index_of(name),
+																		[&](auto i) { ret = std::get<i.value>(m_columns).has_value(row); });
+	return ret;
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX>
+[[nodiscard]] bool BasicParameterTable<NAME_TABLE, PARAMETERS...>::is_set(size_t row) const
+		requires(INDEX < sizeof...(PARAMETERS)) {
+	throw_if_row_out_of_range(row);
+	return std::get<INDEX>(m_columns).has_value(row);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+[[nodiscard]] bool BasicParameterTable<NAME_TABLE, PARAMETERS...>::is_complete(size_t row) const {
+	throw_if_row_out_of_range(row);
+	return std::apply([&](const auto &... columns) { return (columns.has_value(row) && ...); }, m_columns);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename FUNCTION>
+auto BasicParameterTable<NAME_TABLE, PARAMETERS...>::submit(size_t row, FUNCTION &&function) const
+		requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
+	if (!is_complete(row)) {
+		throw std::runtime_error("Unable to call function: No stored value for parameter");
+	}
+	return std::apply([&](const auto &... columns) { return std::invoke(function, columns.value(row)...); },
+										m_columns);
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <typename FUNCTION>
+auto BasicParameterTable<NAME_TABLE, PARAMETERS...>::submit_all(FUNCTION &&function) const
+		requires(std::is_invocable_v<FUNCTION, PARAMETERS...>) {
+	using result_t = std::invoke_result_t<FUNCTION &, const std::remove_cv_t<std::remove_reference_t<PARAMETERS>> &...>;
+	const auto complete = complete_rows();
+	auto for_each_complete_row = [&](auto &&call) {
+		for (size_t w = 0; w < complete.size(); ++w) {
+			for (auto bits = complete[w]; bits != 0; bits &= bits - 1) {
+				const size_t row = w * 64 + detail::count_trailing_zeros(bits);
+				std::apply([&](const auto &... columns) { call(columns.value(row)...); }, m_columns);
+			}
+		}
+	};
+
+	if constexpr (std::is_void_v<result_t>) {
+		for_each_complete_row([&](const auto &... values) { std::invoke(function, values...); });
+	} else {
+		std::vector<result_t> results;
+		for_each_complete_row([&](const auto &... values) { results.push_back(std::invoke(function, values...)); });
+		return results;
+	}
+}
+
+////////////////////// Private Members //////////////////////
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::throw_if_row_out_of_range(size_t row) const {
+	if (row >= m_rows) {
+		throw std::out_of_range("Row index out of range");
+	}
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+template <size_t INDEX>
+void BasicParameterTable<NAME_TABLE, PARAMETERS...>::throw_if_no_value_stored_for(size_t row) const {
+	if (!std::get<INDEX>(m_columns).has_value(row)) {
+		throw std::runtime_error("Parameter does not have a stored value");
+	}
+}
+
+template <typename NAME_TABLE, typename... PARAMETERS>
+std::vector<std::uint64_t> BasicParameterTable<NAME_TABLE, PARAMETERS...>::complete_rows() const {
+	std::vector<std::uint64_t> complete((m_rows + 63) / 64, ~std::uint64_t{0});
+	if (!complete.empty() && m_rows % 64 != 0) {
+		complete.back() = (std::uint64_t{1} << (m_rows % 64)) - 1;
+	}
+	std::apply(
+			[&](const auto &... columns) {
+				for (size_t w = 0; w < complete.size(); ++w) {
+					((complete[w] &= columns.presence()[w]), ...);
+				}
+			},
+			m_columns);
+	return complete;
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////      Utilities       /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief A contiguous column of optional \a T values with a presence bitmap, used by BasicParameterTable.
+ *
+ *  Values are only constructed for rows in which they are present. Trivially copyable values are laid out as a plain
+ *  array of \a T, so they can be bulk copied.
+ */
+template <typename T>
+class Column {
+public:
+	Column() = default;
+	Column(const Column &other) : Column() {
+		reserve(other.m_rows);
+		m_rows = other.m_rows;
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			copy_bytes_from(other, other.m_rows);
+		} else {
+			other.for_each_present([&](size_t row) { emplace(row, other.value(row)); });
+		}
+	}
+	Column(Column &&other) noexcept { swap(other); }
+	Column &operator=(Column other) noexcept {
+		swap(other);
+		return *this;
+	}
+	~Column() { clear(); }
+
+	void swap(Column &other) noexcept {
+		std::swap(m_slots, other.m_slots);
+		std::swap(m_presence, other.m_presence);
+		std::swap(m_rows, other.m_rows);
+		std::swap(m_capacity, other.m_capacity);
+	}
+
+	bool has_value(size_t row) const noexcept { return (m_presence[row / 64] >> (row % 64)) & 1u; }
+	const std::vector<std::uint64_t> &presence() const noexcept { return m_presence; }
+
+	T &value(size_t row) noexcept { return *std::launder(reinterpret_cast<T *>(m_slots[row].bytes)); }
+	const T &value(size_t row) const noexcept { return *std::launder(reinterpret_cast<const T *>(m_slots[row].bytes)); }
+
+	template <typename U>
+	void assign(size_t row, U &&value) {
+		if (has_value(row)) {
+			this->value(row) = forward_decayed<U>(value);
+		} else {
+			emplace(row, forward_decayed<U>(value));
+		}
+	}
+
+	template <typename... ARGS>
+	void emplace(size_t row, ARGS &&... args) {
+		reset(row);
+		::new (static_cast<void *>(m_slots[row].bytes)) T(forward_decayed<ARGS>(args)...);
+		m_presence[row / 64] |= std::uint64_t{1} << (row % 64);
+	}
+
+	void reset(size_t row) noexcept {
+		if (has_value(row)) {
+			value(row).~T();
+			m_presence[row / 64] &= ~(std::uint64_t{1} << (row % 64));
+		}
+	}
+
+	void clear() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for_each_present([&](size_t row) { value(row).~T(); });
+		}
+		std::fill(m_presence.begin(), m_presence.end(), 0);
+	}
+
+	void resize(size_t n_rows) {
+		for (size_t row = n_rows; row < m_rows; ++row) {
+			reset(row);
+		}
+		if (n_rows > m_capacity) {
+			reserve(std::max(n_rows, 2 * m_capacity));
+		}
+		m_rows = n_rows;
+	}
+
+	/**
+	 *  @brief Stores the values in [\a first, \a last) starting at \a first_row, which should all fit in the column.
+	 */
+	template <typename ITERATOR>
+	void fill(size_t first_row, ITERATOR first, ITERATOR last) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			T *const values = reinterpret_cast<T *>(m_slots.get());
+			mark_present(first_row, static_cast<size_t>(std::copy(first, last, values + first_row) - values));
+		} else {
+			for (size_t row = first_row; first != last; ++first, ++row) {
+				assign(row, *first);
+			}
+		}
+	}
+
+	template <typename FUNCTION>
+	void for_each_present(FUNCTION &&function) const {
+		for (size_t w = 0; w < m_presence.size(); ++w) {
+			for (auto bits = m_presence[w]; bits != 0; bits &= bits - 1) {
+				function(w * 64 + count_trailing_zeros(bits));
+			}
+		}
+	}
+
+private:
+	std::unique_ptr<Slot<T>[]> m_slots;
+	std::vector<std::uint64_t> m_presence;
+	size_t m_rows = 0;
+	size_t m_capacity = 0;
+
+	void reserve(size_t capacity) {
+		Column reserved;
+		reserved.m_slots.reset(new Slot<T>[capacity]);
+		reserved.m_presence.assign((capacity + 63) / 64, 0);
+		reserved.m_capacity = capacity;
+		reserved.m_rows = m_rows;
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			reserved.copy_bytes_from(*this, m_rows);
+		} else {
+			for_each_present([&](size_t row) { reserved.emplace(row, std::move_if_noexcept(value(row))); });
+		}
+		swap(reserved);
+	}
+
+	void copy_bytes_from(const Column &other, size_t n_rows) {
+		if (n_rows > 0) {
+			std::memcpy(m_slots.get(), other.m_slots.get(), n_rows * sizeof(T));
+			std::copy(other.m_presence.begin(), other.m_presence.begin() + (n_rows + 63) / 64, m_presence.begin());
+		}
+	}
+
+	void mark_present(size_t first_row, size_t last_row) noexcept {
+		for (size_t row = first_row; row < last_row;) {
+			const size_t bit = row % 64;
+			const size_t n_bits = std::min<size_t>(64 - bit, last_row - row);
+			const auto bits = n_bits == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << n_bits) - 1) << bit;
+			m_presence[row / 64] |= bits;
+			row += n_bits;
+		}
+	}
+};
+}  // namespace detail
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,441 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define QBOUTS_HAS_MAPPED_FILE 1
+#endif
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/////////////////////////////////////////////////////////////
+//////////////////     Serialization    /////////////////////
+/////////////////////////////////////////////////////////////
+
+// A map is serialized into a record, which consists of
+//   - a header: the schema fingerprint of the map (see BasicParameterMap::schema_fingerprint) and the size of the
+//     record, both as std::uint64_t,
+//   - the presence mask: one bit per parameter, in ceil(N / 8) bytes,
+//   - the stored values, in order. Trivially copyable values are written as is, aligned to their alignment. Strings
+//     are written as a std::uint64_t length (aligned to 8 bytes) followed by their characters.
+// Records are padded to a multiple of 16 bytes, so that a buffer holding several records keeps all of them aligned.
+// Values are written in the byte order of the machine, which is part of the fingerprint. Records can only be read into
+// maps with the same schema fingerprint as the map which wrote them.
+//
+// Parameters can be serialized if their type is std::string, std::string_view or a trivially copyable type which is
+// neither a pointer nor over-aligned.
+
+/**
+ *  @brief Appends a record holding the values stored in \a map to \a out.
+ *
+ *  \a out is first padded with zeros to a multiple of 16 bytes, so records appended to the same buffer stay aligned.
+ */
+template <typename MAP>
+void serialize(const MAP &map, std::string &out);
+
+/**
+ *  @brief Returns a record holding the values stored in \a map.
+ */
+template <typename MAP>
+[[nodiscard]] std::string serialize(const MAP &map);
+
+/**
+ *  @brief Reads the record at the start of \a data into \a map, replacing all of its values.
+ *  @return The size of the record, or
+ *    - ParameterError::incompatible_type if the record was written by a map with a different fingerprint,
+ *    - ParameterError::malformed_input if \a data does not start with a complete record.
+ *
+ *  std::string_view parameters refer to \a data. \a map is not modified if an error is returned.
+ */
+template <typename MAP>
+Expected<size_t> deserialize(std::string_view data, MAP &map);
+
+/**
+ *  @brief Gives access to the values of a record in place, without copying or deserializing them.
+ *
+ *  Trivially copyable values are returned as references into the record, strings as views of it. Views are obtained
+ *  from a \a SnapshotReader and remain valid as long as the buffer being read.
+ */
+template <typename MAP>
+class SerializedMapView {
+public:
+	SerializedMapView() = default;
+
+	/**
+	 *  @brief Returns whether a value is stored for the parameter at \a INDEX.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] bool is_set() const noexcept requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Returns a const reference to the value of the parameter at \a INDEX, or a std::string_view for strings.
+	 *  @throw std::runtime_error if no value is stored for the parameter.
+	 */
+	template <size_t INDEX>
+	[[nodiscard]] decltype(auto) get() const requires(INDEX < MAP::size());
+
+	/**
+	 *  @brief Copies the values of the record into \a map, replacing all of its values.
+	 */
+	void copy_to(MAP &map) const;
+
+	/**
+	 *  @brief Returns the bytes of the record.
+	 */
+	[[nodiscard]] std::string_view record() const noexcept { return m_record; }
+
+private:
+	std::string_view m_record;
+	std::array<size_t, MAP::size()> m_offsets{};
+
+	template <typename>
+	friend class SnapshotReader;
+	template <typename T>
+	friend Expected<size_t> deserialize(std::string_view, T &);
+
+	Expected<size_t> index(std::string_view data, std::uint64_t fingerprint) noexcept;
+};
+
+/**
+ *  @brief Reads consecutive records written by \a serialize from a buffer, such as a \a MappedFile.
+ *
+ *  The buffer must be aligned to 16 bytes (which memory mapped files and allocations are), so that trivially copyable
+ *  values can be referenced in place.
+ */
+template <typename MAP>
+class SnapshotReader {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param data The records, which must outlive the reader and all views it returns.
+	 *  @param fingerprint The fingerprint every record should have, see BasicParameterMap::schema_fingerprint.
+	 */
+	SnapshotReader(std::string_view data, std::uint64_t fingerprint) noexcept
+			: m_data(data), m_fingerprint(fingerprint) {}
+
+	/**
+	 *  @brief Makes \a view refer to the next record.
+	 *  @return false if all records have been read, or the error of \a deserialize if the next record can not be read
+	 *    (ParameterError::malformed_input if the buffer is not aligned).
+	 */
+	Expected<bool> next(SerializedMapView<MAP> &view) noexcept;
+
+private:
+	std::string_view m_data;
+	std::uint64_t m_fingerprint;
+};
+
+#if defined(QBOUTS_HAS_MAPPED_FILE)
+/**
+ *  @brief A file mapped read-only into memory.
+ */
+class MappedFile {
+public:
+	/**
+	 *  @brief Maps the file at \a path.
+	 *  @throw std::system_error if the file can not be opened or mapped.
+	 */
+	explicit MappedFile(const std::string &path);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	MappedFile(MappedFile &&other) noexcept : m_data(std::exchange(other.m_data, {})) {}
+	MappedFile &operator=(MappedFile &&other) noexcept;
+
+	/**
+	 *  @brief Returns the contents of the file.
+	 */
+	[[nodiscard]] std::string_view data() const noexcept { return m_data; }
+
+private:
+	std::string_view m_data;
+};
+#endif
+
+
+/////////////////////////////////////////////////////////////
+//////////////////     Serialization    /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+inline constexpr size_t record_alignment = 16;
+inline constexpr size_t record_header_size = 2 * sizeof(std::uint64_t);
+
+template <typename T>
+inline constexpr bool is_serialized_as_string_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <typename T>
+inline constexpr bool is_serializable_v =
+		is_serialized_as_string_v<T> || (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+																		 !std::is_member_pointer_v<T> && !is_borrowed_v<T> &&
+																		 alignof(T) <= record_alignment);
+
+template <typename MAP, size_t INDEX>
+using serialized_type_t = std::remove_cv_t<std::remove_reference_t<typename MAP::template parameter_type<INDEX>>>;
+
+constexpr size_t align_up(size_t size, size_t alignment) noexcept {
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+constexpr size_t presence_mask_size(size_t n_parameters) noexcept { return (n_parameters + 7) / 8; }
+
+template <typename T>
+void append_bytes(std::string &out, const T &value) {
+	out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+void append_value(std::string &out, size_t record_begin, const T &value) {
+	if constexpr (is_serialized_as_string_v<T>) {
+		out.resize(record_begin + align_up(out.size() - record_begin, alignof(std::uint64_t)), '\0');
+		append_bytes(out, static_cast<std::uint64_t>(value.size()));
+		out.append(value.data(), value.size());
+	} else {
+		out.resize(record_begin + align_up(out.size() - record_begin, alignof(T)), '\0');
+		append_bytes(out, value);
+	}
+}
+
+inline std::uint64_t read_uint64(const char *data) noexcept {
+	std::uint64_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+}  // namespace detail
+
+template <typename MAP>
+void serialize(const MAP &map, std::string &out) {
+	constexpr size_t n_parameters = MAP::size();
+	out.resize(detail::align_up(out.size(), detail::record_alignment), '\0');
+	const size_t record_begin = out.size();
+	detail::append_bytes(out, map.schema_fingerprint());
+	detail::append_bytes(out, std::uint64_t{0});
+	const size_t mask_begin = out.size();
+	out.resize(mask_begin + detail::presence_mask_size(n_parameters), '\0');
+
+	detail::static_for<0, n_parameters>([&](auto i) {
+		using value_t = detail::serialized_type_t<MAP, i.value>;
+		static_assert(detail::is_serializable_v<value_t>,
+									"Only std::string, std::string_view and trivially copyable parameters can be serialized");
+		if (map.template is_set<i.value>()) {
+			out[mask_begin + i.value / 8] |= static_cast<char>(1u << (i.value % 8));
+			detail::append_value<value_t>(out, record_begin, map.template get<i.value>());
+		}
+	});
+
+	out.resize(record_begin + detail::align_up(out.size() - record_begin, detail::record_alignment), '\0');
+	const auto record_size = static_cast<std::uint64_t>(out.size() - record_begin);
+	std::memcpy(&out[record_begin + sizeof(std::uint64_t)], &record_size, sizeof(record_size));
+}
+
+template <typename MAP>
+[[nodiscard]] std::string serialize(const MAP &map) {
+	std::string out;
+	serialize(map, out);
+	return out;
+}
+
+template <typename MAP>
+Expected<size_t> deserialize(std::string_view data, MAP &map) {
+	SerializedMapView<MAP> view;
+	const auto record_size = view.index(data, map.schema_fingerprint());
+	if (record_size) {
+		view.copy_to(map);
+	}
+	return record_size;
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   SerializedMapView  /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] bool SerializedMapView<MAP>::is_set() const noexcept requires(INDEX < MAP::size()) {
+	return m_offsets[INDEX] != 0;
+}
+
+template <typename MAP>
+template <size_t INDEX>
+[[nodiscard]] decltype(auto) SerializedMapView<MAP>::get() const requires(INDEX < MAP::size()) {
+	using value_t = detail::serialized_type_t<MAP, INDEX>;
+	if (!is_set<INDEX>()) {
+		throw std::runtime_error("Parameter does not have a stored value");
+	}
+	const char *value = m_record.data() + m_offsets[INDEX];
+	if constexpr (detail::is_serialized_as_string_v<value_t>) {
+		return std::string_view(value + sizeof(std::uint64_t), detail::read_uint64(value));
+	} else {
+		return static_cast<const value_t &>(*reinterpret_cast<const value_t *>(value));
+	}
+}
+
+template <typename MAP>
+void SerializedMapView<MAP>::copy_to(MAP &map) const {
+	map.clear();
+	detail::static_for<0, MAP::size()>([&](auto i) {
+		using value_t = detail::serialized_type_t<MAP, i.value>;
+		if (!is_set<i.value>()) {
+			return;
+		}
+		const char *value = m_record.data() + m_offsets[i.value];
+		if constexpr (detail::is_serialized_as_string_v<value_t>) {
+			map.template emplace<i.value>(value + sizeof(std::uint64_t), detail::read_uint64(value));
+		} else {
+			std::aligned_storage_t<sizeof(value_t), alignof(value_t)> copy;
+			std::memcpy(&copy, value, sizeof(value_t));
+			map.template set<i.value>(*std::launder(reinterpret_cast<const value_t *>(&copy)));
+		}
+	});
+}
+
+////////////////////// Private Members //////////////////////
+
+/**
+ *  Validates the record at the start of \a data and stores the offset of every stored value (0 for missing values).
+ *  Returns the size of the record.
+ */
+template <typename MAP>
+Expected<size_t> SerializedMapView<MAP>::index(std::string_view data, std::uint64_t fingerprint) noexcept {
+	constexpr size_t n_parameters = MAP::size();
+	constexpr size_t values_begin = detail::record_header_size + detail::presence_mask_size(n_parameters);
+	if (data.size() < values_begin) {
+		return ParameterError::malformed_input;
+	}
+	if (detail::read_uint64(data.data()) != fingerprint) {
+		return ParameterError::incompatible_type;
+	}
+	const std::uint64_t record_size = detail::read_uint64(data.data() + sizeof(std::uint64_t));
+	if (record_size > data.size() || record_size < values_begin || record_size % detail::record_alignment != 0) {
+		return ParameterError::malformed_input;
+	}
+
+	const auto *mask = reinterpret_cast<const unsigned char *>(data.data() + detail::record_header_size);
+	size_t position = values_begin;
+	bool is_valid = true;
+	detail::static_for<0, n_parameters>([&](auto i) {
+		using value_t = detail::serialized_type_t<MAP, i.value>;
+		m_offsets[i.value] = 0;
+		if (!is_valid || (mask[i.value / 8] & (1u << (i.value % 8))) == 0) {
+			return;
+		}
+		if constexpr (detail::is_serialized_as_string_v<value_t>) {
+			position = detail::align_up(position, alignof(std::uint64_t));
+			if (position + sizeof(std::uint64_t) > record_size ||
+					detail::read_uint64(data.data() + position) > record_size - position - sizeof(std::uint64_t)) {
+				is_valid = false;
+				return;
+			}
+			m_offsets[i.value] = position;
+			position += sizeof(std::uint64_t) + detail::read_uint64(data.data() + position);
+		} else {
+			position = detail::align_up(position, alignof(value_t));
+			if (position + sizeof(value_t) > record_size) {
+				is_valid = false;
+				return;
+			}
+			m_offsets[i.value] = position;
+			position += sizeof(value_t);
+		}
+	});
+	if (!is_valid || detail::align_up(position, detail::record_alignment) != record_size) {
+		return ParameterError::malformed_input;
+	}
+	m_record = data.substr(0, record_size);
+	return static_cast<size_t>(record_size);
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////    SnapshotReader    /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+template <typename MAP>
+Expected<bool> SnapshotReader<MAP>::next(SerializedMapView<MAP> &view) noexcept {
+	if (m_data.empty()) {
+		return false;
+	}
+	if (reinterpret_cast<std::uintptr_t>(m_data.data()) % detail::record_alignment != 0) {
+		return ParameterError::malformed_input;
+	}
+	const auto record_size = view.index(m_data, m_fingerprint);
+	if (!record_size) {
+		return record_size.error();
+	}
+	m_data.remove_prefix(*record_size);
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////      MappedFile      /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+#if defined(QBOUTS_HAS_MAPPED_FILE)
+inline MappedFile::MappedFile(const std::string &path) {
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw std::system_error(errno, std::generic_category(), "Unable to open " + path);
+	}
+	struct stat status {};
+	if (::fstat(file, &status) != 0) {
+		const int error = errno;
+		::close(file);
+		throw std::system_error(error, std::generic_category(), "Unable to read the size of " + path);
+	}
+	const auto size = static_cast<size_t>(status.st_size);
+	void *data = size > 0 ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) : nullptr;
+	const int error = errno;
+	::close(file);
+	if (data == MAP_FAILED) {
+		throw std::system_error(error, std::generic_category(), "Unable to map " + path);
+	}
+	m_data = std::string_view(static_cast<const char *>(data), size);
+}
+
+inline MappedFile::~MappedFile() {
+	if (!m_data.empty()) {
+		::munmap(const_cast<char *>(m_data.data()), m_data.size());
+	}
+}
+
+inline MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+	if (this != &other) {
+		this->~MappedFile();
+		m_data = std::exchange(other.m_data, {});
+	}
+	return *this;
+}
+#endif
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,213 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef SUBMISSION_QUEUE_H
+#define SUBMISSION_QUEUE_H
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief Options of a \a SubmissionQueue.
+ */
+struct SubmissionQueueOptions {
+	size_t batch_size = 64;  ///< Number of pending entries at which the queue is drained, 0 to only drain on \a flush.
+};
+
+namespace detail {
+template <typename MAP, typename SEQUENCE>
+struct SubmissionTuple;
+
+template <typename TUPLE>
+struct is_tuple_coalescable;
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////
+//////////////////   SubmissionQueue    /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief Collects the values of parameter maps and passes them to a function in batches.
+ *  @tparam MAP The map type of the entries, e.g. ParameterMap<std::string, int>.
+ *  @tparam FUNCTION The function draining the queue. It is called with a std::vector<value_type>&, holding the values
+ *    of the entries of one batch in the order in which they were pushed. It may move the values out of the vector.
+ *  @tparam COALESCE Whether to drop entries whose values equal those of an entry pending in the same batch.
+ *
+ *  Calling a function once per batch rather than once per map lets it share work between the entries, and keeps
+ *  related calls together. When coalescing, entries whose values equal those of an entry already pending are dropped,
+ *  so duplicate requests are handled once per batch. Coalescing requires every value type to be equality comparable
+ *  and to have a std::hash specialization, which is checked at compile time.
+ *
+ *  Borrowed values are copied into the queue. A SubmissionQueue is not thread safe.
+ *
+ *  Entries still pending when the queue is destroyed are dropped without being passed to the function, as draining
+ *  them could throw from the destructor. Call \a flush before destroying the queue, debug builds assert that it is
+ *  empty.
+ */
+template <typename MAP, typename FUNCTION, bool COALESCE = false>
+class SubmissionQueue {
+public:
+	using value_type = typename detail::SubmissionTuple<MAP, std::make_index_sequence<MAP::size()>>::type;
+
+	static_assert(!COALESCE || detail::is_tuple_coalescable<value_type>::value,
+								"Coalescing requires equality comparable parameter values with a std::hash specialization");
+
+	/**
+	 *  @brief Constructor.
+	 *  @param function The function draining the queue.
+	 *  @param options The batch size.
+	 */
+	explicit SubmissionQueue(FUNCTION function, SubmissionQueueOptions options = SubmissionQueueOptions{});
+
+	SubmissionQueue(const SubmissionQueue &) = delete;
+	SubmissionQueue &operator=(const SubmissionQueue &) = delete;
+
+	/**
+	 *  @brief Destructor. Pending entries are dropped, they should be flushed first.
+	 */
+	~SubmissionQueue();
+
+	/**
+	 *  @brief Moves the values of \a map into the queue, and drains the queue once a batch is complete.
+	 *  @return Whether an entry was added, false if it was coalesced with a pending entry.
+	 *  @throw std::runtime_error if not all parameters of \a map have values stored, \a map is not modified then.
+	 *  @throw Any exception thrown by the function draining the queue, see \a flush.
+	 */
+	bool push(MAP &&map);
+
+	/**
+	 *  @brief Passes all pending entries to the function, if there are any.
+	 *  @return The number of entries passed to the function.
+	 *  @throw Any exception thrown by the function. The entries passed to it are discarded.
+	 */
+	size_t flush();
+
+	/**
+	 *  @brief Returns the number of pending entries.
+	 */
+	[[nodiscard]] size_t size() const noexcept { return m_pending.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return m_pending.empty(); }
+
+private:
+	struct EntryHash {
+		const std::vector<value_type> *entries;
+		size_t operator()(size_t index) const;
+	};
+
+	struct EntryEqual {
+		const std::vector<value_type> *entries;
+		bool operator()(size_t lhs, size_t rhs) const;
+	};
+
+	FUNCTION m_function;
+	SubmissionQueueOptions m_options;
+	std::vector<value_type> m_pending;
+	std::vector<value_type> m_batch;                               // The batch being drained, reused between batches.
+	std::unordered_set<size_t, EntryHash, EntryEqual> m_coalesced;  // Indices of the pending entries, if COALESCE.
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   SubmissionQueue    /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+template <typename MAP, size_t... I>
+struct SubmissionTuple<MAP, std::index_sequence<I...>> {
+	using type = std::tuple<
+			std::remove_cv_t<std::remove_reference_t<borrowed_value_t<typename MAP::template parameter_type<I>>>>...>;
+};
+
+template <typename T, typename = void>
+struct is_coalescable : std::false_type {};
+template <typename T>
+struct is_coalescable<T,
+											std::enable_if_t<std::is_default_constructible_v<std::hash<T>> &&
+																			 std::is_convertible_v<decltype(std::declval<const T &>() == std::declval<const T &>()),
+																															 bool>>> : std::true_type {};
+
+template <typename... TYPES>
+struct is_tuple_coalescable<std::tuple<TYPES...>> : std::bool_constant<(is_coalescable<TYPES>::value && ...)> {};
+}  // namespace detail
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+SubmissionQueue<MAP, FUNCTION, COALESCE>::SubmissionQueue(FUNCTION function, SubmissionQueueOptions options)
+		: m_function(std::move(function)),
+			m_options(options),
+			m_coalesced(0, EntryHash{&m_pending}, EntryEqual{&m_pending}) {
+	m_pending.reserve(m_options.batch_size);
+}
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+SubmissionQueue<MAP, FUNCTION, COALESCE>::~SubmissionQueue() {
+	assert(m_pending.empty() && "Pending entries of a SubmissionQueue should be flushed before it is destroyed");
+}
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+bool SubmissionQueue<MAP, FUNCTION, COALESCE>::push(MAP &&map) {
+	std::move(map).submit([&](auto &&... values) { m_pending.emplace_back(std::forward<decltype(values)>(values)...); });
+	if constexpr (COALESCE) {
+		if (!m_coalesced.insert(m_pending.size() - 1).second) {
+			m_pending.pop_back();
+			return false;
+		}
+	}
+	if (m_pending.size() == m_options.batch_size) {
+		flush();
+	}
+	return true;
+}
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+size_t SubmissionQueue<MAP, FUNCTION, COALESCE>::flush() {
+	if (m_pending.empty()) {
+		return 0;
+	}
+	m_coalesced.clear();
+	m_batch.swap(m_pending);
+	const size_t n_entries = m_batch.size();
+	try {
+		std::invoke(m_function, m_batch);
+	} catch (...) {
+		m_batch.clear();
+		throw;
+	}
+	m_batch.clear();
+	return n_entries;
+}
+
+////////////////////// Private Members //////////////////////
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+size_t SubmissionQueue<MAP, FUNCTION, COALESCE>::EntryHash::operator()(size_t index) const {
+	return std::apply(
+			[](const auto &... values) {
+				std::uint64_t hash = 0;
+				((hash = detail::combine_hashes(hash, std::hash<std::decay_t<decltype(values)>>{}(values))), ...);
+				return static_cast<size_t>(hash);
+			},
+			(*entries)[index]);
+}
+
+template <typename MAP, typename FUNCTION, bool COALESCE>
+bool SubmissionQueue<MAP, FUNCTION, COALESCE>::EntryEqual::operator()(size_t lhs, size_t rhs) const {
+	return (*entries)[lhs] == (*entries)[rhs];
+}
+
+}  // namespace qbouts
+
+#endif
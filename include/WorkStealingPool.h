@@ -0,0 +1,191 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace qbouts {
+
+namespace detail {
+/**
+ *  @brief Blocks until \a predicate holds, as \a condition.wait(lock, predicate).
+ *
+ *  The untimed wait of libstdc++ is exported from the library since GCC 12 (GLIBCXX_3.4.30), the timed wait is inline.
+ *  Waiting for a deadline which is never reached keeps binaries compatible with older runtimes.
+ */
+template <typename PREDICATE>
+void wait(std::condition_variable &condition, std::unique_lock<std::mutex> &lock, PREDICATE predicate) {
+	condition.wait_until(lock, std::chrono::steady_clock::time_point::max(), std::move(predicate));
+}
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////
+//////////////////   WorkStealingPool   /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief A fixed size thread pool in which every worker has its own task queue and idle workers steal tasks.
+ *
+ *  Tasks executed from one of the pool's workers are pushed onto that worker's own queue and popped in LIFO order,
+ *  which keeps related work on the same core. Tasks executed from other threads are distributed over the queues
+ *  round robin. A worker whose queue is empty steals the oldest task of another worker, idle workers sleep until a
+ *  task is executed.
+ *
+ *  Tasks should not throw: an exception escaping a task terminates the program.
+ *  The destructor runs all tasks which have been executed before joining the workers.
+ */
+class WorkStealingPool {
+public:
+	/**
+	 *  @brief Constructor.
+	 *  @param n_threads The number of worker threads, at least one worker is always started.
+	 */
+	explicit WorkStealingPool(size_t n_threads = std::thread::hardware_concurrency());
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool &) = delete;
+	WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+	/**
+	 *  @brief Schedules \a task to be called on one of the workers.
+	 */
+	template <typename TASK>
+	void execute(TASK &&task);
+
+	/**
+	 *  @brief Returns the number of worker threads.
+	 */
+	[[nodiscard]] size_t size() const noexcept { return m_threads.size(); }
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> m_queues;
+	std::vector<std::thread> m_threads;
+	std::atomic<size_t> m_next_queue{0};
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	size_t m_n_pending = 0;
+	bool m_stop = false;
+
+	static inline thread_local const WorkStealingPool *current_pool = nullptr;
+	static inline thread_local size_t current_queue = 0;
+
+	void run_worker(size_t index);
+	bool try_pop(size_t index, std::function<void()> &task);
+};
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   WorkStealingPool   /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+inline WorkStealingPool::WorkStealingPool(size_t n_threads) {
+	n_threads = std::max<size_t>(n_threads, 1);
+	for (size_t i = 0; i < n_threads; ++i) {
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	for (size_t i = 0; i < n_threads; ++i) {
+		m_threads.emplace_back([this, i] { run_worker(i); });
+	}
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for (auto &thread : m_threads) {
+		thread.join();
+	}
+}
+
+template <typename TASK>
+void WorkStealingPool::execute(TASK &&task) {
+	const size_t index =
+			current_pool == this ? current_queue : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+	{
+		// Counted before it is pushed, so a worker which pops it can not decrement the count below zero.
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_n_pending;
+	}
+	try {
+		std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+		m_queues[index]->tasks.emplace_back(std::forward<TASK>(task));
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		--m_n_pending;
+		throw;
+	}
+	m_wake.notify_one();
+}
+
+////////////////////// Private Members //////////////////////
+
+inline void WorkStealingPool::run_worker(size_t index) {
+	current_pool = this;
+	current_queue = index;
+	std::function<void()> task;
+	while (true) {
+		if (try_pop(index, task)) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				--m_n_pending;
+			}
+			task();
+			task = nullptr;
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(m_mutex);
+		detail::wait(m_wake, lock, [&] { return m_stop || m_n_pending > 0; });
+		if (m_stop && m_n_pending == 0) {
+			return;
+		}
+	}
+}
+
+inline bool WorkStealingPool::try_pop(size_t index, std::function<void()> &task) {
+	{
+		auto &own = *m_queues[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			return true;
+		}
+	}
+	for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+		auto &victim = *m_queues[(index + offset) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty()) {
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+}  // namespace qbouts
+
+#endif
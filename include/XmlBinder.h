@@ -0,0 +1,267 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#ifndef XML_BINDER_H
+#define XML_BINDER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "ParameterBinding.h"
+#include "ParameterMap.h"
+
+namespace qbouts {
+
+/**
+ *  @brief An element read by an XmlElementReader. All members refer to the buffer being read.
+ */
+struct XmlElement {
+	std::string_view name;        ///< The name of the element.
+	std::string_view attributes;  ///< The raw attributes of the element, e.g. type="double".
+	std::string_view content;     ///< The raw content between the start and end tag, including any child elements.
+};
+
+/////////////////////////////////////////////////////////////
+//////////////////   XmlElementReader   /////////////////////
+/////////////////////////////////////////////////////////////
+
+/**
+ *  @brief Reads the elements at the top level of an XML buffer one by one, without copying or building a tree.
+ *
+ *  Comments, processing instructions, declarations and text between the elements are skipped. Child elements are not
+ *  read but are part of the \a content of their parent, which can be read using another XmlElementReader. Entities
+ *  and CDATA sections are left as is.
+ */
+class XmlElementReader {
+public:
+	explicit XmlElementReader(std::string_view xml) noexcept : m_xml(xml) {}
+
+	/**
+	 *  @brief Reads the next element into \a element.
+	 *  @return false if there are no more elements.
+	 *  @throw std::runtime_error if the XML is malformed.
+	 */
+	bool next(XmlElement &element);
+
+private:
+	std::string_view m_xml;
+	size_t m_position = 0;
+
+	bool skip_markup(size_t &position) const;
+	size_t end_of_tag(size_t position) const;
+	size_t find(std::string_view text, size_t position) const;
+};
+
+/**
+ *  @brief Sets a parameter of \a map for every element at the top level of \a xml, e.g. <size type="double">56.5</size>.
+ *  @param xml The elements, the element name identifies the parameter and its content is the value.
+ *  @param map The map in which the values are stored.
+ *  @param policy What to do with elements which do not match any parameter.
+ *  @return The number of parameters set.
+ *  @throw std::runtime_error if the XML is malformed.
+ *  @throw std::invalid_argument if a value can not be parsed into its parameter (or, depending on \a policy, if an
+ *    element does not match any parameter).
+ *
+ *  Values are converted directly from the buffer according to the type of their parameter (see detail::parse_value),
+ *  any type attribute is therefore ignored. Entities and CDATA sections are only decoded for std::string parameters,
+ *  std::string_view parameters refer to the buffer.
+ */
+template <typename MAP>
+size_t bind_xml(std::string_view xml, MAP &map, UnknownParameterPolicy policy = UnknownParameterPolicy::ignore);
+
+
+/////////////////////////////////////////////////////////////
+//////////////////   XmlElementReader   /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+inline bool XmlElementReader::next(XmlElement &element) {
+	while (skip_markup(m_position)) {
+	}
+	if (m_position >= m_xml.size()) {
+		return false;
+	}
+
+	const size_t name_begin = m_position + 1;
+	const size_t tag_end = end_of_tag(m_position);
+	const size_t name_end = std::min(m_xml.find_first_of(" \t\r\n/>", name_begin), tag_end);
+	if (name_end == name_begin) {
+		throw std::runtime_error("Malformed XML: element without a name");
+	}
+	element.name = m_xml.substr(name_begin, name_end - name_begin);
+	const bool is_empty = m_xml[tag_end - 1] == '/';
+	element.attributes = detail::trim(m_xml.substr(name_end, tag_end - name_end - (is_empty ? 1 : 0)));
+	m_position = tag_end + 1;
+	if (is_empty) {
+		element.content = {};
+		return true;
+	}
+
+	const size_t content_begin = m_position;
+	for (size_t depth = 1; depth > 0;) {
+		const size_t tag_begin = find("<", m_position);
+		m_position = tag_begin;
+		if (skip_markup(m_position)) {
+			continue;
+		}
+		const size_t end = end_of_tag(tag_begin);
+		if (m_xml[tag_begin + 1] == '/') {
+			if (--depth == 0) {
+				if (detail::trim(m_xml.substr(tag_begin + 2, end - tag_begin - 2)) != element.name) {
+					throw std::runtime_error("Malformed XML: mismatched end tag of element " + std::string(element.name));
+				}
+				element.content = m_xml.substr(content_begin, tag_begin - content_begin);
+			}
+		} else if (m_xml[end - 1] != '/') {
+			++depth;
+		}
+		m_position = end + 1;
+	}
+	return true;
+}
+
+////////////////////// Private Members //////////////////////
+
+/**
+ *  Skips text, a comment, a CDATA section, a processing instruction or a declaration starting at \a position.
+ *  Returns whether anything was skipped, leaves \a position at the next tag (or the end) otherwise.
+ */
+inline bool XmlElementReader::skip_markup(size_t &position) const {
+	const size_t tag_begin = std::min(m_xml.find('<', position), m_xml.size());
+	if (tag_begin != position) {
+		position = tag_begin;
+		return true;
+	}
+	const std::string_view rest = m_xml.substr(position);
+	if (rest.substr(0, 4) == "<!--") {
+		position = find("-->", position + 4) + 3;
+	} else if (rest.substr(0, 9) == "<![CDATA[") {
+		position = find("]]>", position + 9) + 3;
+	} else if (rest.substr(0, 2) == "<?") {
+		position = find("?>", position + 2) + 2;
+	} else if (rest.substr(0, 2) == "<!") {
+		position = end_of_tag(position) + 1;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+/**
+ *  Returns the position of the '>' closing the tag starting at \a position, skipping quoted attribute values.
+ */
+inline size_t XmlElementReader::end_of_tag(size_t position) const {
+	char quote = '\0';
+	for (size_t i = position + 1; i < m_xml.size(); ++i) {
+		const char c = m_xml[i];
+		if (quote != '\0') {
+			quote = c == quote ? '\0' : quote;
+		} else if (c == '"' || c == '\'') {
+			quote = c;
+		} else if (c == '>') {
+			return i;
+		}
+	}
+	throw std::runtime_error("Malformed XML: unterminated tag");
+}
+
+inline size_t XmlElementReader::find(std::string_view text, size_t position) const {
+	const size_t found = m_xml.find(text, position);
+	if (found == std::string_view::npos) {
+		throw std::runtime_error("Malformed XML: expected " + std::string(text));
+	}
+	return found;
+}
+
+
+/////////////////////////////////////////////////////////////
+//////////////////       bind_xml       /////////////////////
+//////////////////    Implementation    /////////////////////
+/////////////////////////////////////////////////////////////
+
+namespace detail {
+/**
+ *  @brief Text format of XML content: the predefined and numeric character entities, and CDATA sections.
+ */
+struct XmlText {
+	static bool is_escaped(std::string_view text) noexcept {
+		return text.find('&') != std::string_view::npos || text.find("<![CDATA[") != std::string_view::npos;
+	}
+
+	static void unescape(std::string_view text, std::string &out) {
+		while (!text.empty()) {
+			const size_t special = text.find_first_of("&<");
+			out.append(text.substr(0, special));
+			if (special == std::string_view::npos) {
+				return;
+			}
+			text.remove_prefix(special);
+			if (text.substr(0, 9) == "<![CDATA[") {
+				const size_t end = text.find("]]>");
+				if (end == std::string_view::npos) {
+					throw std::runtime_error("Malformed XML: unterminated CDATA section");
+				}
+				out.append(text.substr(9, end - 9));
+				text.remove_prefix(end + 3);
+			} else if (text[0] == '<') {
+				out.push_back('<');
+				text.remove_prefix(1);
+			} else {
+				const size_t end = text.find(';');
+				if (end == std::string_view::npos) {
+					throw std::runtime_error("Malformed XML: unterminated entity");
+				}
+				append_entity(text.substr(1, end - 1), out);
+				text.remove_prefix(end + 1);
+			}
+		}
+	}
+
+	static void append_entity(std::string_view entity, std::string &out) {
+		if (entity == "lt") {
+			out.push_back('<');
+		} else if (entity == "gt") {
+			out.push_back('>');
+		} else if (entity == "amp") {
+			out.push_back('&');
+		} else if (entity == "quot") {
+			out.push_back('"');
+		} else if (entity == "apos") {
+			out.push_back('\'');
+		} else if (entity.size() > 1 && entity[0] == '#') {
+			const bool is_hex = entity[1] == 'x';
+			std::uint32_t code_point = 0;
+			const auto digits = entity.substr(is_hex ? 2 : 1);
+			const auto [end, error] =
+					std::from_chars(digits.data(), digits.data() + digits.size(), code_point, is_hex ? 16 : 10);
+			if (error != std::errc{} || end != digits.data() + digits.size()) {
+				throw std::runtime_error("Malformed XML: invalid character reference &" + std::string(entity) + ";");
+			}
+			append_utf8(code_point, out);
+		} else {
+			throw std::runtime_error("Malformed XML: unknown entity &" + std::string(entity) + ";");
+		}
+	}
+};
+}  // namespace detail
+
+template <typename MAP>
+size_t bind_xml(std::string_view xml, MAP &map, UnknownParameterPolicy policy) {
+	size_t n_bound = 0;
+	XmlElementReader reader(xml);
+	for (XmlElement element; reader.next(element);) {
+		n_bound += detail::bind_value<detail::XmlText>(map, element.name, element.content, policy) ? 1 : 0;
+	}
+	return n_bound;
+}
+
+}  // namespace qbouts
+
+#endif
@@ -0,0 +1,122 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncSubmit.h"
+#include "ParameterMap.h"
+#include "WorkStealingPool.h"
+
+namespace {
+using qbouts::ParameterMap;
+using qbouts::submit_async;
+using qbouts::WorkStealingPool;
+
+using TextureParams = ParameterMap<std::string, std::unique_ptr<std::vector<char>>>;
+
+TextureParams make_params(const std::string& path, size_t size) {
+	TextureParams params{"path", "data"};
+	params.set("path", path);
+	params.set("data", std::make_unique<std::vector<char>>(size));
+	return params;
+}
+
+std::string decode(std::string path, std::unique_ptr<std::vector<char>> data) {
+	return path + ":" + std::to_string(data->size());
+}
+
+class AsyncSubmitTestSuite : public ::testing::Test {
+protected:
+	WorkStealingPool m_pool{4};
+};
+
+TEST_F(AsyncSubmitTestSuite, CallsAreMadeOnTheExecutor) {
+	const auto caller = std::this_thread::get_id();
+	std::vector<std::future<std::string>> results;
+	for (size_t i = 0; i < 16; ++i) {
+		results.push_back(submit_async(make_params("texture" + std::to_string(i), i),
+																	 [&](std::string path, std::unique_ptr<std::vector<char>> data) {
+																		 EXPECT_NE(std::this_thread::get_id(), caller);
+																		 return decode(std::move(path), std::move(data));
+																	 },
+																	 m_pool));
+	}
+	for (size_t i = 0; i < results.size(); ++i) {
+		EXPECT_EQ(results[i].get(), "texture" + std::to_string(i) + ":" + std::to_string(i));
+	}
+}
+
+TEST_F(AsyncSubmitTestSuite, CopiesLeaveTheMapUntouched) {
+	ParameterMap<int, std::string> params{"width", "name"};
+	params.set("width", 64);
+	params.set("name", std::string("brick"));
+	const auto describe = [](int width, const std::string& name) { return name + std::to_string(width); };
+	auto result = submit_async(params, describe, m_pool);
+	params.set("width", 128);
+	EXPECT_EQ(result.get(), "brick64");
+	EXPECT_EQ(params.get<std::string>("name"), "brick");
+
+	std::atomic<int> n_calls{0};
+	submit_async(params, [&](int, const std::string&) { ++n_calls; }, m_pool).get();
+	EXPECT_EQ(n_calls, 1);
+}
+
+TEST_F(AsyncSubmitTestSuite, ExceptionsArePropagatedThroughTheFuture) {
+	TextureParams incomplete{"path", "data"};
+	incomplete.set("path", std::string("missing"));
+	EXPECT_THROW(submit_async(std::move(incomplete), &decode, m_pool).get(), std::runtime_error);
+
+	const auto reject = [](const std::string&, const std::unique_ptr<std::vector<char>>&) -> int {
+		throw std::invalid_argument("corrupt");
+	};
+	auto failing = submit_async(make_params("corrupt", 0), reject, m_pool);
+	EXPECT_THROW(failing.get(), std::invalid_argument);
+}
+
+#if defined(QBOUTS_REQUIRE_COROUTINES) && !defined(QBOUTS_HAS_COROUTINES)
+#error "The coroutine build of AsyncSubmit_gTest is compiled without coroutine support"
+#endif
+
+#if defined(QBOUTS_HAS_COROUTINES)
+/**
+ *  A coroutine which starts immediately and reports its result through a std::promise.
+ */
+struct DetachedTask {
+	struct promise_type {
+		DetachedTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+DetachedTask decode_all(WorkStealingPool& pool, std::promise<std::string>& result) {
+	std::string decoded = co_await qbouts::submit_awaitable(make_params("first", 1), &decode, pool);
+	decoded += "," + co_await qbouts::submit_awaitable(make_params("second", 2), &decode, pool);
+	try {
+		TextureParams incomplete{"path", "data"};
+		co_await qbouts::submit_awaitable(std::move(incomplete), &decode, pool);
+	} catch (const std::runtime_error&) {
+		decoded += ",rethrown";
+	}
+	result.set_value(decoded);
+}
+
+TEST_F(AsyncSubmitTestSuite, AwaitablesResumeWithTheResult) {
+	std::promise<std::string> result;
+	decode_all(m_pool, result);
+	EXPECT_EQ(result.get_future().get(), "first:1,second:2,rethrown");
+}
+#endif
+}  // namespace
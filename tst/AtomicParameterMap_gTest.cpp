@@ -0,0 +1,112 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AtomicParameterMap.h"
+#include "ParameterMap.h"
+
+namespace {
+using qbouts::AtomicParameterMap;
+using qbouts::ParameterMap;
+
+template <size_t, typename T>
+using repeat_t = T;
+
+template <size_t... I>
+auto make_int_map(std::index_sequence<I...>) {
+	const std::vector<std::string> names{("p" + std::to_string(I))...};
+	return ParameterMap<repeat_t<I, int>...>{names[I]...};
+}
+
+class AtomicParameterMapTestSuite : public ::testing::Test {};
+
+TEST_F(AtomicParameterMapTestSuite, ResetRacingWithSetNeverExposesAValueThatWasNotSet) {
+	using CounterParams = ParameterMap<std::int64_t, bool>;
+	AtomicParameterMap<CounterParams> map{CounterParams{"generation", "enabled"}};
+	std::atomic<bool> done{false};
+	std::atomic<int> n_invalid{0};
+	std::thread resetter([&] {
+		while (!done) {
+			map.reset<0>();
+		}
+	});
+	std::thread reader([&] {
+		while (!done) {
+			try {
+				n_invalid += map.get<0>() < 1 ? 1 : 0;
+			} catch (const std::runtime_error&) {
+				// Reset between the presence check and the load.
+			}
+			n_invalid += map.is_set<1>() ? 1 : 0;
+		}
+	});
+	// Writes for a fixed time rather than a fixed count, so that the threads also interleave on a single core.
+	const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+	for (std::int64_t generation = 1; std::chrono::steady_clock::now() < end; ++generation) {
+		map.set<0>(generation);
+	}
+	done = true;
+	resetter.join();
+	reader.join();
+	EXPECT_EQ(n_invalid, 0);
+
+	map.reset<0>();
+	EXPECT_FALSE(map.is_set<0>());
+	EXPECT_THROW((void)map.get<std::int64_t>("generation"), std::runtime_error);
+	map.set<0>(7);
+	EXPECT_EQ(map.get<0>(), 7);
+	EXPECT_FALSE(map.is_set<1>());
+}
+
+TEST_F(AtomicParameterMapTestSuite, SetByIndexConvertsLikeParameterMap) {
+	using LimitParams = ParameterMap<int, std::int8_t, float>;
+	LimitParams params{"count", "level", "scale"};
+	AtomicParameterMap<LimitParams> map{params};
+	map.set<0>(2.75);
+	map.set<1>(300);
+	map.set<2>(0.1);
+	params.set<0>(2.75);
+	params.set<1>(300);
+	params.set<2>(0.1);
+	EXPECT_EQ(map.get<0>(), 2);
+	EXPECT_EQ(map.get<1>(), params.get<1>());
+	EXPECT_EQ(map.get<2>(), params.get<2>());
+	EXPECT_EQ(map.get<2>(), 0.1f);
+
+	// By name only values converting to the parameter type are accepted, as for ParameterMap.
+	EXPECT_THROW(map.set("count", std::string("3")), std::invalid_argument);
+	map.set("count", 3.5);
+	EXPECT_EQ(map.get<int>("count"), 3);
+}
+
+TEST_F(AtomicParameterMapTestSuite, MapsWithSixtyFourParametersUseEveryPresenceBit) {
+	// With a 65th parameter the map fails to compile, the presence bits are a single 64 bit word.
+	const auto params = make_int_map(std::make_index_sequence<64>{});
+	AtomicParameterMap<std::remove_const_t<decltype(params)>> map{params};
+	const auto sum = [](auto... values) { return (0 + ... + values); };
+	map.set<63>(63);
+	EXPECT_TRUE(map.is_set<63>());
+	EXPECT_FALSE(map.is_set<62>());
+	EXPECT_THROW(map.submit(sum), std::runtime_error);
+
+	qbouts::detail::static_for<0, 63>([&](auto i) { map.template set<i.value>(static_cast<int>(i.value)); });
+	EXPECT_EQ(map.submit(sum), 63 * 64 / 2);
+	map.reset<0>();
+	EXPECT_THROW(map.submit(sum), std::runtime_error);
+	EXPECT_EQ(map.snapshot().get<63>(), 63);
+	EXPECT_FALSE(map.snapshot().is_set<0>());
+}
+}  // namespace
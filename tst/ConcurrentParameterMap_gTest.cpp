@@ -0,0 +1,101 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentParameterMap.h"
+#include "ParameterMap.h"
+
+namespace {
+using qbouts::ConcurrentParameterMap;
+using qbouts::ParameterMap;
+
+// Spans eight of the map's 64 bit words, which are stored one at a time.
+struct Histogram {
+	std::array<std::int64_t, 8> bins;
+};
+
+class ConcurrentParameterMapTestSuite : public ::testing::Test {};
+
+TEST_F(ConcurrentParameterMapTestSuite, ParametersWhichWereNeverSetAreNotSet) {
+	ParameterMap<double, bool> params{"rate", "enabled"};
+	params.set("rate", 0.5);
+	ConcurrentParameterMap<ParameterMap<double, bool>> map{params};
+	EXPECT_TRUE(map.is_set<0>());
+	EXPECT_FALSE(map.is_set<1>());
+	EXPECT_THROW((void)map.get<1>(), std::runtime_error);
+	EXPECT_THROW((void)map.get<bool>("enabled"), std::runtime_error);
+	EXPECT_THROW(map.submit([](double, bool) {}), std::runtime_error);
+	EXPECT_FALSE(map.snapshot().is_set<1>());
+
+	map.set<0>(1.5);
+	EXPECT_FALSE(map.is_set<1>());
+	map.set("enabled", false);
+	EXPECT_TRUE(map.is_set<1>());
+	EXPECT_FALSE(map.get<bool>("enabled"));
+}
+
+TEST_F(ConcurrentParameterMapTestSuite, UpdatesArePublishedAsAWholeOrNotAtAll) {
+	using TuningParams = ParameterMap<double, bool>;
+	ConcurrentParameterMap<TuningParams> map{TuningParams{"rate", "enabled"}};
+	map.update([](TuningParams& params) {
+		params.set("rate", 2.0);
+		params.set("enabled", false);
+	});
+	EXPECT_EQ(map.get<0>(), 2.0);
+	EXPECT_FALSE(map.get<1>());
+
+	EXPECT_THROW(map.update([](TuningParams& params) {
+		params.set("rate", 3.0);
+		throw std::logic_error("abort");
+	}),
+							 std::logic_error);
+	EXPECT_EQ(map.get<0>(), 2.0);
+}
+
+TEST_F(ConcurrentParameterMapTestSuite, ValuesSpanningSeveralWordsAreNotTorn) {
+	using HistogramParams = ParameterMap<Histogram, bool>;
+	HistogramParams params{"histogram", "enabled"};
+	params.set("histogram", Histogram{});
+	ConcurrentParameterMap<HistogramParams> map{params};
+
+	std::atomic<bool> done{false};
+	std::atomic<int> n_torn{0};
+	std::atomic<int> n_spuriously_set{0};
+	auto is_torn = [](const Histogram& histogram) {
+		return std::adjacent_find(histogram.bins.begin(), histogram.bins.end(), std::not_equal_to<>{}) !=
+					 histogram.bins.end();
+	};
+	std::thread reader([&] {
+		while (!done) {
+			n_torn += is_torn(map.get<0>()) ? 1 : 0;
+			n_spuriously_set += map.is_set<1>() ? 1 : 0;
+		}
+	});
+	// Writes for a fixed time rather than a fixed count, so that the writer is also preempted on a single core.
+	const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+	std::int64_t n_writes = 0;
+	while (std::chrono::steady_clock::now() < end) {
+		Histogram histogram;
+		histogram.bins.fill(++n_writes);
+		map.set<0>(histogram);
+	}
+	done = true;
+	reader.join();
+	EXPECT_EQ(n_torn, 0);
+	EXPECT_EQ(n_spuriously_set, 0);
+	EXPECT_EQ(map.get<0>().bins.back(), n_writes);
+}
+}  // namespace
@@ -0,0 +1,119 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "JsonBinder.h"
+#include "ParameterMap.h"
+
+namespace {
+using qbouts::bind_json;
+using qbouts::ParameterError;
+using qbouts::ParameterMap;
+using qbouts::UnknownParameterPolicy;
+
+class JsonBinderTestSuite : public ::testing::Test {
+protected:
+	ParameterMap<const std::string&, double, bool, int> m_params{"path", "size_percent", "flip", "count"};
+};
+
+TEST_F(JsonBinderTestSuite, MembersAreBoundToParametersOfTheirType) {
+	const std::string_view json = R"(
+		{
+			"path": "car.png",
+			"size_percent": 56.5,
+			"flip": true,
+			"count": -3,
+			"extra": {"nested": ["}", {"a": 1}], "escaped \" brace {": null}
+		})";
+	const auto n_bound = bind_json(json, m_params);
+	ASSERT_TRUE(n_bound);
+	EXPECT_EQ(*n_bound, 4);
+	EXPECT_EQ(m_params.get<std::string>("path"), "car.png");
+	EXPECT_EQ(m_params.get<double>("size_percent"), 56.5);
+	EXPECT_TRUE(m_params.get<bool>("flip"));
+	EXPECT_EQ(m_params.get<int>("count"), -3);
+
+	EXPECT_EQ(*bind_json("{}", m_params), 0);
+	EXPECT_EQ(*bind_json(R"({"count": null})", m_params), 0);
+	EXPECT_EQ(m_params.get<int>("count"), -3);
+}
+
+TEST_F(JsonBinderTestSuite, EscapesAreDecodedForStringsAndNames) {
+	ASSERT_TRUE(bind_json(R"({"path": "a\\b \"c\"\n\u00e9\ud83d\ude00"})", m_params));
+	EXPECT_EQ(m_params.get<std::string>("path"), "a\\b \"c\"\n\xC3\xA9\xF0\x9F\x98\x80");
+
+	const std::string long_value(100, 'x');
+	ASSERT_TRUE(bind_json(R"({"path": ")" + long_value + R"(\t"})", m_params));
+	EXPECT_EQ(m_params.get<std::string>("path"), long_value + "\t");
+
+	const std::string_view json = R"({"name": "Homer", "age": 38})";
+	ParameterMap<std::string_view, int> view_params{"name", "age"};
+	ASSERT_TRUE(bind_json(json, view_params));
+	EXPECT_EQ(view_params.get<std::string_view>("name").data(), json.data() + 10);
+	EXPECT_EQ(view_params.get<int>("age"), 38);
+	EXPECT_EQ(bind_json(R"({"name": "a\nb"})", view_params).error(), ParameterError::invalid_value);
+}
+
+TEST_F(JsonBinderTestSuite, MismatchesAreReportedWithoutThrowing) {
+	EXPECT_EQ(bind_json(R"({"size_percent": "large"})", m_params).error(), ParameterError::incompatible_type);
+	EXPECT_EQ(bind_json(R"({"flip": 1})", m_params).error(), ParameterError::incompatible_type);
+	EXPECT_EQ(bind_json(R"({"count": [1]})", m_params).error(), ParameterError::incompatible_type);
+	EXPECT_EQ(bind_json(R"({"count": 1.5})", m_params).error(), ParameterError::invalid_value);
+	EXPECT_EQ(bind_json(R"({"count": 1e99})", m_params).error(), ParameterError::invalid_value);
+
+	EXPECT_EQ(*bind_json(R"({"color": "red"})", m_params), 0);
+	EXPECT_EQ(bind_json(R"({"color": "red"})", m_params, UnknownParameterPolicy::reject).error(),
+						ParameterError::unknown_name);
+}
+
+TEST_F(JsonBinderTestSuite, MalformedJsonIsReported) {
+	for (std::string_view json : {"",
+																"[]",
+																R"({"count": 1)",
+																R"({"count" 1})",
+																R"({"count": 1,})",
+																R"({"count": 1} x)",
+																R"({"path": "unterminated})",
+																R"({"path": "\q"})",
+																R"({"path": "\u12"})",
+																R"({"flip": tru})",
+																R"({"extra": {"a": [1, 2})"}) {
+		const auto n_bound = bind_json(json, m_params);
+		ASSERT_FALSE(n_bound) << json;
+		EXPECT_EQ(n_bound.error(), ParameterError::malformed_input) << json;
+	}
+}
+
+TEST_F(JsonBinderTestSuite, NumbersMustFollowTheJsonGrammar) {
+	for (auto [json, value] : {std::pair{R"({"size_percent": 0})", 0.0},
+														 std::pair{R"({"size_percent": -0.5})", -0.5},
+														 std::pair{R"({"size_percent": 10})", 10.0},
+														 std::pair{R"({"size_percent": 1.25e2})", 125.0},
+														 std::pair{R"({"size_percent": 25E-1})", 2.5},
+														 std::pair{R"({"size_percent": -1e+1})", -10.0}}) {
+		ASSERT_TRUE(bind_json(json, m_params)) << json;
+		EXPECT_EQ(m_params.get<double>("size_percent"), value) << json;
+	}
+	for (std::string_view json : {R"({"size_percent": 01})",
+																R"({"size_percent": -01})",
+																R"({"size_percent": 1.})",
+																R"({"size_percent": .5})",
+																R"({"size_percent": 1.e5})",
+																R"({"size_percent": 1e})",
+																R"({"size_percent": 1e+})",
+																R"({"size_percent": -})",
+																R"({"size_percent": +1})",
+																R"({"color": 01})"}) {
+		const auto n_bound = bind_json(json, m_params);
+		ASSERT_FALSE(n_bound) << json;
+		EXPECT_EQ(n_bound.error(), ParameterError::malformed_input) << json;
+	}
+}
+}  // namespace
@@ -0,0 +1,83 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "KeyValueBinder.h"
+#include "ParameterMap.h"
+
+namespace {
+using qbouts::bind_args;
+using qbouts::bind_ini;
+using qbouts::ParameterMap;
+using qbouts::UnknownParameterPolicy;
+
+class KeyValueBinderTestSuite : public ::testing::Test {
+protected:
+	ParameterMap<std::string_view, double, bool, int> m_params{"path", "size_percent", "flip", "count"};
+};
+
+TEST_F(KeyValueBinderTestSuite, OptionsAreBoundToParametersOfTheirType) {
+	const char *argv[] = {"tool", "--path", "car.png", "--size_percent=56.5", "--flip", "--count", "-3"};
+	EXPECT_EQ(bind_args(7, argv, m_params), 4);
+	EXPECT_EQ(m_params.get<std::string_view>("path").data(), argv[2]);
+	EXPECT_EQ(m_params.get<double>("size_percent"), 56.5);
+	EXPECT_TRUE(m_params.get<bool>("flip"));
+	EXPECT_EQ(m_params.get<int>("count"), -3);
+
+	const char *flag_with_value[] = {"tool", "--flip", "false", "--verbose", "--color", "red"};
+	EXPECT_EQ(bind_args(6, flag_with_value, m_params), 1);
+	EXPECT_FALSE(m_params.get<bool>("flip"));
+}
+
+TEST_F(KeyValueBinderTestSuite, InvalidArgumentsThrow) {
+	const char *positional[] = {"tool", "car.png"};
+	EXPECT_THROW(bind_args(2, positional, m_params), std::invalid_argument);
+	const char *missing_value[] = {"tool", "--count"};
+	EXPECT_THROW(bind_args(2, missing_value, m_params), std::invalid_argument);
+	const char *invalid_value[] = {"tool", "--count", "many"};
+	EXPECT_THROW(bind_args(3, invalid_value, m_params), std::invalid_argument);
+	const char *unknown[] = {"tool", "--color", "red"};
+	EXPECT_THROW(bind_args(3, unknown, m_params, UnknownParameterPolicy::reject), std::invalid_argument);
+}
+
+TEST_F(KeyValueBinderTestSuite, IniEntriesOfTheRequestedSectionAreBound) {
+	const std::string_view ini =
+			"; textures\r\n"
+			"count = 2\r\n"
+			"\n"
+			"[car]\n"
+			"path = \" car.png \"\n"
+			"# comment\n"
+			"size_percent=56.5\n"
+			"[ tree ]\n"
+			"path = tree.png\n"
+			"flip = 1\n";
+	EXPECT_EQ(bind_ini(ini, m_params), 1);
+	EXPECT_EQ(m_params.get<int>("count"), 2);
+
+	EXPECT_EQ(bind_ini(ini, m_params, "car"), 2);
+	EXPECT_EQ(m_params.get<std::string_view>("path"), " car.png ");
+	EXPECT_EQ(m_params.get<double>("size_percent"), 56.5);
+	EXPECT_FALSE(m_params.is_set("flip"));
+
+	EXPECT_EQ(bind_ini(ini, m_params, "tree"), 2);
+	EXPECT_EQ(m_params.get<std::string_view>("path"), "tree.png");
+	EXPECT_TRUE(m_params.get<bool>("flip"));
+}
+
+TEST_F(KeyValueBinderTestSuite, MalformedIniThrows) {
+	EXPECT_THROW(bind_ini("count", m_params), std::runtime_error);
+	EXPECT_THROW(bind_ini("[car\ncount = 1", m_params), std::runtime_error);
+	EXPECT_THROW(bind_ini("count = many", m_params), std::invalid_argument);
+	EXPECT_EQ(bind_ini("color = red", m_params), 0);
+	EXPECT_THROW(bind_ini("color = red", m_params, {}, UnknownParameterPolicy::reject), std::invalid_argument);
+	EXPECT_EQ(bind_ini("[other]\nnot an entry", m_params), 0);
+}
+}  // namespace
@@ -0,0 +1,113 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ParallelSubmit.h"
+#include "ParameterMap.h"
+#include "WorkStealingPool.h"
+
+namespace {
+using qbouts::ExceptionPolicy;
+using qbouts::ParallelSubmitOptions;
+using qbouts::ParameterMap;
+using qbouts::submit_parallel;
+using qbouts::WorkStealingPool;
+
+class ParallelSubmitTestSuite : public ::testing::Test {
+protected:
+	ParallelSubmitTestSuite() {
+		for (int i = 0; i < 1000; ++i) {
+			m_maps.emplace_back("myInt", "name");
+			m_maps.back().set("myInt", i);
+			m_maps.back().set("name", "map" + std::to_string(i));
+		}
+	}
+
+	WorkStealingPool m_pool{4};
+	std::vector<ParameterMap<int, const std::string&>> m_maps;
+};
+
+TEST_F(ParallelSubmitTestSuite, PoolRunsAllTasksIncludingNestedOnes) {
+	std::atomic<int> n_runs{0};
+	{
+		WorkStealingPool pool{3};
+		EXPECT_EQ(pool.size(), 3);
+		for (int i = 0; i < 100; ++i) {
+			pool.execute([&] {
+				++n_runs;
+				pool.execute([&] { ++n_runs; });
+			});
+		}
+	}
+	EXPECT_EQ(n_runs, 200);
+}
+
+TEST_F(ParallelSubmitTestSuite, ResultsAreReturnedInOrder) {
+	for (size_t grain_size : {0, 1, 7, 1000, 5000}) {
+		auto results = submit_parallel(
+				m_maps,
+				[](int i, const std::string& name) { return name + ":" + std::to_string(i); },
+				m_pool,
+				ParallelSubmitOptions{grain_size});
+		ASSERT_EQ(results.size(), m_maps.size());
+		for (int i = 0; i < 1000; ++i) {
+			EXPECT_EQ(results[i], "map" + std::to_string(i) + ":" + std::to_string(i));
+		}
+	}
+}
+
+TEST_F(ParallelSubmitTestSuite, VoidFunctionsAreCalledForEveryMap) {
+	std::atomic<long> sum{0};
+	submit_parallel(m_maps, [&](int i, const std::string&) { sum += i; }, m_pool);
+	EXPECT_EQ(sum, 999 * 1000 / 2);
+
+	std::vector<ParameterMap<int, const std::string&>> no_maps;
+	EXPECT_TRUE(submit_parallel(no_maps, [](int, const std::string&) { return 1; }, m_pool).empty());
+}
+
+TEST_F(ParallelSubmitTestSuite, FirstExceptionIsPropagatedAndOutstandingWorkCancelled) {
+	std::atomic<int> n_calls{0};
+	auto throw_at_zero = [&](int i, const std::string&) {
+		++n_calls;
+		if (i == 0) {
+			throw std::logic_error("zero");
+		}
+		return i;
+	};
+	EXPECT_THROW(submit_parallel(m_maps, throw_at_zero, m_pool, ParallelSubmitOptions{1, ExceptionPolicy::cancel}),
+							 std::logic_error);
+	EXPECT_LT(n_calls, 1000);
+
+	n_calls = 0;
+	EXPECT_THROW(submit_parallel(m_maps, throw_at_zero, m_pool, ParallelSubmitOptions{1, ExceptionPolicy::complete}),
+							 std::logic_error);
+	EXPECT_EQ(n_calls, 1000);
+}
+
+TEST_F(ParallelSubmitTestSuite, IncompleteMapsPropagateRuntimeError) {
+	m_maps[500].clear();
+	EXPECT_THROW(submit_parallel(m_maps, [](int, const std::string&) {}, m_pool), std::runtime_error);
+}
+
+TEST_F(ParallelSubmitTestSuite, SubmitParallelCanBeNestedInPoolTasks) {
+	WorkStealingPool pool{1};
+	std::atomic<size_t> n_results{0};
+	std::atomic<bool> done{false};
+	pool.execute([&] {
+		n_results = submit_parallel(m_maps, [](int i, const std::string&) { return i; }, pool).size();
+		done = true;
+	});
+	while (!done) {
+		std::this_thread::yield();
+	}
+	EXPECT_EQ(n_results, 1000);
+}
+}  // namespace
@@ -0,0 +1,120 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParameterMap.h"
+#include "ParameterMapHandle.h"
+
+namespace {
+using qbouts::ParameterMap;
+using qbouts::ParameterMapHandle;
+
+using ServiceParams = ParameterMap<std::string, int>;
+
+class ParameterMapHandleTestSuite : public ::testing::Test {};
+
+TEST_F(ParameterMapHandleTestSuite, UpdatesPublishANewSnapshotOrNothing) {
+	ServiceParams params{"endpoint", "timeout"};
+	params.set("endpoint", std::string("localhost"));
+	params.set("timeout", 0);
+	ParameterMapHandle<ServiceParams> handle{params};
+
+	handle.update([](ServiceParams& params) {
+		params.set("endpoint", std::string("example.com"));
+		params.set("timeout", 30);
+	});
+	const auto address = [](const std::string& endpoint, int timeout) {
+		return endpoint + ":" + std::to_string(timeout);
+	};
+	EXPECT_EQ(handle.submit(address), "example.com:30");
+
+	EXPECT_THROW(handle.update([](ServiceParams& params) {
+		params.set("timeout", 60);
+		throw std::logic_error("abort");
+	}),
+							 std::logic_error);
+	EXPECT_EQ(handle.submit(address), "example.com:30");
+	EXPECT_EQ(handle.reclaim(), 0u);
+}
+
+TEST_F(ParameterMapHandleTestSuite, SnapshotsAreReclaimedOnceNoLongerRead) {
+	ServiceParams params{"endpoint", "timeout"};
+	params.set("endpoint", std::string("localhost"));
+	params.set("timeout", 0);
+	ParameterMapHandle<ServiceParams> handle{params};
+
+	handle.read([&](const ServiceParams& outer) {
+		std::thread writer([&] {
+			for (int i = 1; i <= 3; ++i) {
+				handle.update([i](ServiceParams& params) { params.set("timeout", i); });
+			}
+			EXPECT_EQ(handle.reclaim(), 3u);
+		});
+		writer.join();
+		// Nested reads see the latest snapshot, the outer one remains valid.
+		EXPECT_EQ(handle.read([](const ServiceParams& params) { return params.get<int>("timeout"); }), 3);
+		EXPECT_EQ(outer.get<int>("timeout"), 0);
+		EXPECT_EQ(outer.get<std::string>("endpoint"), "localhost");
+	});
+	EXPECT_EQ(handle.reclaim(), 0u);
+}
+
+TEST_F(ParameterMapHandleTestSuite, SnapshotsReadByAnotherThreadAreKeptUntilItsReadEnds) {
+	ParameterMap<int> params{"timeout"};
+	params.set("timeout", 0);
+	ParameterMapHandle<ParameterMap<int>> handle{params};
+
+	std::promise<void> reading;
+	std::promise<void> updated;
+	std::thread reader([&] {
+		handle.read([&](const ParameterMap<int>& snapshot) {
+			reading.set_value();
+			updated.get_future().wait();
+			EXPECT_EQ(snapshot.get<int>("timeout"), 0);
+		});
+	});
+	reading.get_future().wait();
+	handle.update([](ParameterMap<int>& params) { params.set("timeout", 1); });
+	EXPECT_EQ(handle.reclaim(), 1u);  // Still retired, the reader may use it.
+	updated.set_value();
+	reader.join();
+	handle.update([](ParameterMap<int>& params) { params.set("timeout", 2); });
+	EXPECT_EQ(handle.reclaim(), 0u);
+}
+
+TEST_F(ParameterMapHandleTestSuite, ReadsOfDistinctHandlesCanBeNested) {
+	ParameterMap<int> params{"timeout"};
+	params.set("timeout", 0);
+	ParameterMapHandle<ParameterMap<int>> handle{params};
+	std::vector<std::unique_ptr<ParameterMapHandle<ParameterMap<int>>>> others;
+	for (int i = 0; i < 8; ++i) {
+		others.push_back(std::make_unique<ParameterMapHandle<ParameterMap<int>>>(params));
+	}
+
+	handle.read([&](const ParameterMap<int>& outer) {
+		for (auto& other : others) {
+			other->submit([](int) {});
+			other->update([](ParameterMap<int>& params) { params.set("timeout", 1); });
+			EXPECT_EQ(other->reclaim(), 0u);
+		}
+		others.resize(4);  // Slots of destroyed handles are returned by the next read of a new handle.
+		ParameterMapHandle<ParameterMap<int>> last{params};
+		last.submit([](int) {});
+
+		handle.update([](ParameterMap<int>& params) { params.set("timeout", 1); });
+		EXPECT_EQ(handle.reclaim(), 1u);
+		EXPECT_EQ(outer.get<int>("timeout"), 0);
+	});
+	EXPECT_EQ(handle.reclaim(), 0u);
+}
+}  // namespace
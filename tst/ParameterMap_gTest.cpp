@@ -7,13 +7,22 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "ParameterMap.h"
 
 namespace {
+using qbouts::MergePolicy;
+using qbouts::ParameterError;
 using qbouts::ParameterMap;
+using qbouts::Borrowed;
+using qbouts::BoundParameterMap;
+using qbouts::SchemaParameterMap;
+using qbouts::StaticParameterMap;
 using qbouts::detail::static_for;
 
 class ParameterMapTestSuite : public ::testing::Test {};
@@ -195,6 +204,504 @@ TEST_F(ParameterMapTestSuite, SubmittingParametersToFunctionCallsFunctionWithCor
 	EXPECT_EQ(name, "Homer Simpson");
 }
 
+struct TestParameterNames {
+	static constexpr std::array<std::string_view, 3> value{"myInt", "enabled", "name"};
+};
+
+TEST_F(ParameterMapTestSuite, StaticParameterMapParametersCanBeSetAndRetrievedByName) {
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> map;
+	map.set("myInt", 3);
+	map.set("enabled", true);
+	map.set("name", "Homer Simpson");
+
+	EXPECT_EQ(map.get<int>("myInt"), 3);
+	EXPECT_EQ(map.get<bool>("enabled"), true);
+	EXPECT_EQ(map.get<std::string>("name"), "Homer Simpson");
+	EXPECT_TRUE(map.is_set("name"));
+	EXPECT_EQ(map.submit([](int a, bool b, const std::string& c) { return c + std::to_string(a) + std::to_string(b); }),
+						"Homer Simpson31");
+}
+
+TEST_F(ParameterMapTestSuite, StaticParameterMapWithIncorrectNameOrTypeThrowsInvalidArgument) {
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> map;
+	EXPECT_THROW(map.set("not_myInt", 3), std::invalid_argument);
+	EXPECT_THROW(map.set("myInt", "Homer Simpson"), std::invalid_argument);
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.get<double>("myInt"), std::invalid_argument);
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.is_set("myIn"), std::invalid_argument);
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.is_set(""), std::invalid_argument);
+}
+
+const qbouts::ParameterSchema<3> test_schema{"myInt", "enabled", "name"};
+
+TEST_F(ParameterMapTestSuite, SchemaParameterMapsShareTheirNames) {
+	SchemaParameterMap<int, bool, const std::string&> map{test_schema};
+	map.set("myInt", 3);
+	map.set("name", "Homer Simpson");
+	auto copy = map;
+	copy.set("enabled", true);
+
+	EXPECT_EQ(copy.get<int>("myInt"), 3);
+	EXPECT_FALSE(map.is_set("enabled"));
+	EXPECT_EQ(copy.submit([](int a, bool b, const std::string& c) { return c + std::to_string(a) + std::to_string(b); }),
+						"Homer Simpson31");
+	EXPECT_THROW(map.set("not_myInt", 3), std::invalid_argument);
+	EXPECT_THROW(map.set("myInt", "Homer Simpson"), std::invalid_argument);
+	EXPECT_EQ(test_schema.name(2), "name");
+	EXPECT_THROW([[maybe_unused]] auto dummy = test_schema.name(3), std::out_of_range);
+	EXPECT_THROW(qbouts::ParameterSchema<2>("myInt", "myInt"), std::invalid_argument);
+}
+
+TEST_F(ParameterMapTestSuite, BoundParameterMapsOnlyStoreTheirValues) {
+	using storage_t = qbouts::detail::ParameterStorage<int, bool, std::string>;
+	BoundParameterMap<test_schema, int, bool, const std::string&> map;
+	map.set("enabled", true);
+	EXPECT_TRUE(map.get<bool>("enabled"));
+	EXPECT_THROW(map.set("not_myInt", 3), std::invalid_argument);
+
+	EXPECT_EQ(sizeof(map), sizeof(storage_t));
+	EXPECT_EQ(sizeof(SchemaParameterMap<int, bool, const std::string&>), sizeof(storage_t) + sizeof(void*));
+}
+
+TEST_F(ParameterMapTestSuite, PerfectHashTableFindsEveryNameAndRejectsOthers) {
+	constexpr std::array<std::string_view, 24> names{
+			"path",  "size_percent", "flip",   "wrap_s", "wrap_t", "min_filter", "mag_filter", "mipmaps",
+			"srgb",  "anisotropy",   "lod",    "bias",   "width",  "height",     "depth",      "format",
+			"swizzle", "compression", "alpha", "premul", "name",   "group",      "priority",   "streaming"};
+	constexpr qbouts::detail::PerfectHashTable<names.size()> table{names};
+	static_assert(table.find("priority") == 22);
+	for (size_t i = 0; i < names.size(); ++i) {
+		EXPECT_EQ(table.find(names[i]), i);
+	}
+	EXPECT_EQ(table.find("paths"), names.size());
+	EXPECT_EQ(table.find(""), names.size());
+	EXPECT_EQ(qbouts::detail::PerfectHashTable<0>{{}}.find("path"), 0);
+}
+
+TEST_F(ParameterMapTestSuite, KeysCanBeUsedToSetAndGetParametersOfEveryInstance) {
+	using map_t = ParameterMap<int, bool, const std::string&>;
+	map_t map{"myInt", "enabled", "name"};
+	map_t other_map{"myInt", "enabled", "name"};
+	const auto name_key = map.key("name");
+	const auto enabled_key = map.key("enabled");
+	EXPECT_EQ(name_key.index(), 2);
+	EXPECT_NE(name_key, enabled_key);
+
+	EXPECT_FALSE(map.is_set(name_key));
+	map.set(name_key, "Homer Simpson");
+	map.set(enabled_key, true);
+	other_map.set(name_key, "Marge Simpson");
+
+	EXPECT_TRUE(map.is_set(name_key));
+	EXPECT_EQ(map.get<std::string>(name_key), "Homer Simpson");
+	EXPECT_EQ(map.get<bool>(enabled_key), true);
+	EXPECT_EQ(other_map.get<std::string>(name_key), "Marge Simpson");
+	EXPECT_FALSE(other_map.is_set(enabled_key));
+}
+
+TEST_F(ParameterMapTestSuite, KeysRejectUnknownNamesAndIncompatibleTypes) {
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> map;
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.key("not_myInt"), std::invalid_argument);
+	const auto key = map.key("myInt");
+	EXPECT_THROW(map.set(key, "Homer Simpson"), std::invalid_argument);
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.get<int>(key), std::runtime_error);
+	EXPECT_THROW([[maybe_unused]] auto dummy = map.get<std::string>(key), std::invalid_argument);
+}
+
+struct CopyCounter {
+	explicit CopyCounter(int* copies, std::string payload = "") : copies(copies), payload(std::move(payload)) {}
+	CopyCounter(const CopyCounter& other) : copies(other.copies), payload(other.payload) { ++*copies; }
+	CopyCounter(CopyCounter&&) = default;
+	CopyCounter& operator=(const CopyCounter& other) {
+		copies = other.copies;
+		payload = other.payload;
+		++*copies;
+		return *this;
+	}
+	CopyCounter& operator=(CopyCounter&&) = default;
+
+	int* copies;
+	std::string payload;
+};
+
+TEST_F(ParameterMapTestSuite, SettingRvalueParametersDoesNotCopyThem) {
+	int copies = 0;
+	ParameterMap<int, CopyCounter> map{"myInt", "counter"};
+	map.set("counter", CopyCounter{&copies});
+	map.set(1, CopyCounter{&copies});
+	map.set(map.key("counter"), CopyCounter{&copies});
+	map.set<1>(CopyCounter{&copies});
+	EXPECT_EQ(copies, 0);
+
+	CopyCounter counter{&copies};
+	map.set("counter", counter);
+	EXPECT_EQ(copies, 1);
+}
+
+TEST_F(ParameterMapTestSuite, ParametersCanBeEmplaced) {
+	int copies = 0;
+	ParameterMap<int, CopyCounter, const std::string&> map{"myInt", "counter", "name"};
+	map.emplace("counter", &copies, "Homer Simpson");
+	EXPECT_EQ(map.get<CopyCounter>("counter").payload, "Homer Simpson");
+	map.emplace(1, &copies, "Marge Simpson");
+	EXPECT_EQ(map.get<CopyCounter>(1).payload, "Marge Simpson");
+	map.emplace(map.key("name"), 3, 'a');
+	EXPECT_EQ(map.get<std::string>("name"), "aaa");
+	map.emplace<0>(42);
+	EXPECT_EQ(map.get<0>(), 42);
+	EXPECT_EQ(copies, 0);
+
+	EXPECT_THROW(map.emplace("myInt", &copies), std::invalid_argument);
+	EXPECT_THROW(map.emplace("not_myInt", 3), std::invalid_argument);
+	EXPECT_THROW(map.emplace(3, 3), std::out_of_range);
+}
+
+TEST_F(ParameterMapTestSuite, ConsumingSubmitMovesStoredValuesAndClearsMap) {
+	int copies = 0;
+	ParameterMap<int, CopyCounter> map{"myInt", "counter"};
+	map.set("myInt", 3);
+	map.emplace("counter", &copies, "Homer Simpson");
+
+	auto consume = [](int a, CopyCounter&& counter) { return counter.payload + std::to_string(a); };
+	EXPECT_EQ(map.submit_and_consume(consume), "Homer Simpson3");
+	EXPECT_EQ(copies, 0);
+	EXPECT_FALSE(map.is_set(0));
+	EXPECT_FALSE(map.is_set(1));
+
+	map.set("myInt", 4);
+	map.emplace("counter", &copies, "Marge Simpson");
+	auto take_by_value = [](int a, CopyCounter counter) { return counter.payload + std::to_string(a); };
+	EXPECT_EQ(std::move(map).submit(take_by_value), "Marge Simpson4");
+	EXPECT_EQ(copies, 0);
+	EXPECT_FALSE(map.is_set(1));
+}
+
+TEST_F(ParameterMapTestSuite, ConsumingSubmitDoesNotModifyMapWhenNotAllParametersAreSet) {
+	ParameterMap<int, const std::string&> map{"myInt", "name"};
+	map.set("name", "Homer Simpson");
+	EXPECT_THROW(map.submit_and_consume([](int, std::string&&) {}), std::runtime_error);
+	EXPECT_EQ(map.get<std::string>("name"), "Homer Simpson");
+}
+
+TEST_F(ParameterMapTestSuite, ConsumingSubmitClearsMapWhenFunctionThrows) {
+	ParameterMap<int> map{"myInt"};
+	map.set("myInt", 3);
+	EXPECT_THROW(map.submit_and_consume([](int) { throw std::logic_error("error"); }), std::logic_error);
+	EXPECT_FALSE(map.is_set("myInt"));
+}
+
+TEST_F(ParameterMapTestSuite, CopiedAndMovedMapsContainTheSameValues) {
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	map.set("myInt", 3);
+	map.set("name", "Homer Simpson");
+
+	auto copy = map;
+	EXPECT_EQ(copy.get<int>("myInt"), 3);
+	EXPECT_FALSE(copy.is_set("enabled"));
+	EXPECT_EQ(copy.get<std::string>("name"), "Homer Simpson");
+
+	ParameterMap<int, bool, const std::string&> assigned{"myInt", "enabled", "name"};
+	assigned.set("enabled", true);
+	assigned = copy;
+	EXPECT_FALSE(assigned.is_set("enabled"));
+	EXPECT_EQ(assigned.get<std::string>("name"), "Homer Simpson");
+
+	auto moved = std::move(copy);
+	EXPECT_EQ(moved.get<int>("myInt"), 3);
+	EXPECT_EQ(moved.get<std::string>("name"), "Homer Simpson");
+}
+
+TEST_F(ParameterMapTestSuite, StoredValuesAreDestroyedOnClearResetAndDestruction) {
+	auto value = std::make_shared<int>(3);
+	{
+		ParameterMap<std::shared_ptr<int>, int> map{"ptr", "myInt"};
+		map.set("ptr", value);
+		EXPECT_EQ(value.use_count(), 2);
+		map.clear();
+		EXPECT_EQ(value.use_count(), 1);
+		map.set("ptr", value);
+		map.set("ptr", value);
+		EXPECT_EQ(value.use_count(), 2);
+		auto copy = map;
+		EXPECT_EQ(value.use_count(), 3);
+	}
+	EXPECT_EQ(value.use_count(), 1);
+}
+
+struct ThrowingCopy {
+	ThrowingCopy() = default;
+	ThrowingCopy(const ThrowingCopy&) { throw std::runtime_error("copy failed"); }
+	ThrowingCopy& operator=(const ThrowingCopy&) = default;
+};
+
+TEST_F(ParameterMapTestSuite, ValuesCopiedBeforeAThrowingCopyAreDestroyed) {
+	auto value = std::make_shared<int>(3);
+	using ThrowingMap = ParameterMap<std::shared_ptr<int>, ThrowingCopy>;
+	ThrowingMap map{"ptr", "thrower"};
+	map.set("ptr", value);
+	map.emplace<1>();
+	EXPECT_EQ(value.use_count(), 2);
+	EXPECT_THROW(ThrowingMap{map}, std::runtime_error);
+	EXPECT_EQ(value.use_count(), 2);
+}
+
+TEST_F(ParameterMapTestSuite, PresenceMaskStorageIsSmallerThanOptionals) {
+	using storage_t = qbouts::detail::ParameterStorage<int, int, int, int, bool, bool>;
+	EXPECT_LT(sizeof(storage_t), sizeof(std::tuple<std::optional<int>, std::optional<int>, std::optional<int>,
+																					 std::optional<int>, std::optional<bool>, std::optional<bool>>));
+
+	qbouts::detail::PresenceMask<70> mask;
+	EXPECT_TRUE(mask.none());
+	for (size_t i = 0; i < 70; ++i) {
+		mask.set(i);
+	}
+	EXPECT_TRUE(mask.all());
+	mask.reset(65);
+	EXPECT_FALSE(mask.all());
+	EXPECT_FALSE(mask.test(65));
+	EXPECT_TRUE(mask.test(64));
+}
+
+TEST_F(ParameterMapTestSuite, TrySetReportsErrorsWithoutThrowing) {
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	EXPECT_TRUE(map.try_set("myInt", 3));
+	EXPECT_TRUE(map.try_set(2, "Homer Simpson"));
+	EXPECT_TRUE(map.try_set(map.key("enabled"), true));
+	EXPECT_EQ(map.try_set("not_myInt", 3).error(), ParameterError::unknown_name);
+	EXPECT_EQ(map.try_set(3, 3).error(), ParameterError::index_out_of_range);
+	EXPECT_EQ(map.try_set("myInt", "Homer Simpson").error(), ParameterError::incompatible_type);
+	EXPECT_THROW(map.try_set("myInt", "Homer Simpson").value(), std::logic_error);
+	EXPECT_EQ(map.get<int>("myInt"), 3);
+	EXPECT_EQ(map.get<std::string>("name"), "Homer Simpson");
+}
+
+TEST_F(ParameterMapTestSuite, TryGetReportsErrorsWithoutThrowing) {
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	EXPECT_EQ(map.try_get<int>("myInt").error(), ParameterError::no_value_stored);
+	map.set("name", "Homer Simpson");
+
+	auto name = map.try_get<std::string>("name");
+	ASSERT_TRUE(name.has_value());
+	EXPECT_EQ(&*name, &map.get<std::string>("name"));
+	EXPECT_EQ(name->size(), 13);
+	EXPECT_EQ(map.try_get<std::string>(2).value(), "Homer Simpson");
+	EXPECT_EQ(*map.try_get<std::string>(map.key("name")), "Homer Simpson");
+
+	EXPECT_EQ(map.try_get<int>("not_myInt").error(), ParameterError::unknown_name);
+	EXPECT_EQ(map.try_get<int>(5).error(), ParameterError::index_out_of_range);
+	EXPECT_EQ(map.try_get<int>("name").error(), ParameterError::incompatible_type);
+	EXPECT_EQ(map.try_key("not_myInt").error(), ParameterError::unknown_name);
+	EXPECT_EQ(map.try_key("enabled").value().index(), 1);
+}
+
+TEST_F(ParameterMapTestSuite, TrySubmitReportsMissingValuesWithoutThrowing) {
+	ParameterMap<int, const std::string&> map{"myInt", "name"};
+	auto concatenate = [](int a, const std::string& b) { return b + std::to_string(a); };
+	EXPECT_EQ(map.try_submit(concatenate).error(), ParameterError::no_value_stored);
+	map.set("myInt", 3);
+	map.set("name", "Homer Simpson");
+	EXPECT_EQ(map.try_submit(concatenate).value(), "Homer Simpson3");
+
+	int calls = 0;
+	EXPECT_TRUE(map.try_submit([&](int, const std::string&) { ++calls; }));
+	EXPECT_EQ(calls, 1);
+	EXPECT_STREQ(qbouts::describe(ParameterError::no_value_stored), "Parameter does not have a stored value");
+}
+
+TEST_F(ParameterMapTestSuite, NamesAreCopiedAndComparedInFull) {
+	std::string buffer = "myInt";
+	auto map = std::make_unique<ParameterMap<int, bool>>(std::string_view(buffer), std::string("enabled"));
+	buffer = "other";
+	map->set("myInt", 3);
+	EXPECT_THROW(map->set("other", 3), std::invalid_argument);
+	EXPECT_THROW(map->set("myIn", 3), std::invalid_argument);
+	EXPECT_THROW(map->set("myInt2", 3), std::invalid_argument);
+
+	auto copy = *map;
+	map.reset();
+	EXPECT_EQ(copy.get<int>("myInt"), 3);
+	copy.set("enabled", true);
+	auto moved = std::move(copy);
+	EXPECT_EQ(copy.key("enabled").index(), 1);
+	EXPECT_TRUE(moved.get<bool>("enabled"));
+}
+
+TEST_F(ParameterMapTestSuite, SingleParameterMapsCanBeCopiedAndMoved) {
+	ParameterMap<int> map{"myInt"};
+	map.set("myInt", 3);
+	ParameterMap<int> copy = map;
+	ParameterMap<int> moved = std::move(copy);
+	copy = map;
+	EXPECT_EQ(copy.get<int>("myInt"), 3);
+	EXPECT_EQ(moved.get<int>("myInt"), 3);
+	EXPECT_EQ(moved.name(0), "myInt");
+}
+
+TEST_F(ParameterMapTestSuite, LiteralNamesAreReferenced) {
+	static constexpr char int_name[] = "myInt";
+	ParameterMap<int, const std::string&> map{qbouts::literal_names, int_name, "name"};
+	EXPECT_EQ(map.name(0).data(), int_name);
+	static_assert(!std::is_constructible_v<ParameterMap<int>, qbouts::LiteralNames, std::string>);
+	map.set("myInt", 3);
+	map.set("name", "Homer Simpson");
+	EXPECT_EQ(map.get<int>("myInt"), 3);
+	EXPECT_EQ(map.get<1>(), "Homer Simpson");
+	EXPECT_THROW(map.set("not_myInt", 3), std::invalid_argument);
+}
+
+TEST_F(ParameterMapTestSuite, NamesCanBeReadBackByIndex) {
+	ParameterMap<int, bool> map{"myInt", "enabled"};
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> static_map;
+	SchemaParameterMap<int, bool, const std::string&> schema_map{test_schema};
+	BoundParameterMap<test_schema, int, bool, const std::string&> bound_map;
+	EXPECT_EQ(map.name(1), "enabled");
+	EXPECT_EQ(static_map.name(2), "name");
+	EXPECT_EQ(schema_map.name(0), "myInt");
+	EXPECT_EQ(bound_map.name(2), "name");
+	EXPECT_THROW((void)map.name(2), std::out_of_range);
+}
+
+struct OtherParameterNames {
+	static constexpr std::array<std::string_view, 3> value{"myInt", "enabled", "title"};
+};
+
+TEST_F(ParameterMapTestSuite, FingerprintsDependOnTypesAndCompileTimeNames) {
+	using StaticMap = StaticParameterMap<TestParameterNames, int, bool, const std::string&>;
+	static_assert(ParameterMap<int, bool>::fingerprint == ParameterMap<const int&, bool>::fingerprint);
+	static_assert(ParameterMap<int, bool>::fingerprint != ParameterMap<bool, int>::fingerprint);
+	static_assert(ParameterMap<int, bool>::fingerprint != ParameterMap<long, bool>::fingerprint);
+	static_assert(StaticMap::fingerprint !=
+								StaticParameterMap<OtherParameterNames, int, bool, const std::string&>::fingerprint);
+
+	const ParameterMap<int, bool, std::string> runtime_map{"myInt", "enabled", "name"};
+	const SchemaParameterMap<int, bool, std::string> schema_map{test_schema};
+	EXPECT_EQ(StaticMap{}.schema_fingerprint(), StaticMap::fingerprint);
+	EXPECT_EQ(runtime_map.schema_fingerprint(), StaticMap::fingerprint);
+	EXPECT_EQ(schema_map.schema_fingerprint(), StaticMap::fingerprint);
+	const ParameterMap<int, bool, std::string> renamed_map{"myInt", "enabled", "title"};
+	EXPECT_NE(renamed_map.schema_fingerprint(), StaticMap::fingerprint);
+}
+
+TEST_F(ParameterMapTestSuite, SubmitWithDefaultsPassesValuesFromEitherMapByReference) {
+	ParameterMap<int, bool, const std::string&> defaults{"myInt", "enabled", "name"};
+	defaults.set("myInt", 1);
+	defaults.set("name", "Marge Simpson");
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	map.set("name", "Homer Simpson");
+
+	const std::string* passed_name = nullptr;
+	const int* passed_int = nullptr;
+	EXPECT_THROW(map.submit_with_defaults(defaults, [](int, bool, const std::string&) {}), std::runtime_error);
+	map.set("enabled", true);
+	map.submit_with_defaults(defaults, [&](const int& a, bool, const std::string& c) {
+		passed_int = &a;
+		passed_name = &c;
+	});
+	EXPECT_EQ(passed_int, &defaults.get<int>("myInt"));
+	EXPECT_EQ(passed_name, &map.get<std::string>("name"));
+	EXPECT_FALSE(map.is_set("myInt"));
+}
+
+TEST_F(ParameterMapTestSuite, WithDefaultsViewFallsBackToDefaults) {
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> defaults;
+	defaults.set("myInt", 1);
+	defaults.set("name", "Marge Simpson");
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	map.set("name", "Homer Simpson");
+
+	const auto view = map.with_defaults(defaults);
+	EXPECT_EQ(view.get<int>("myInt"), 1);
+	EXPECT_EQ(view.get<std::string>(2), "Homer Simpson");
+	EXPECT_EQ(&view.get<0>(), &defaults.get<int>("myInt"));
+	EXPECT_TRUE(view.is_set("myInt"));
+	EXPECT_FALSE(view.is_set(1));
+	EXPECT_FALSE(view.is_set<1>());
+	EXPECT_THROW([[maybe_unused]] auto& dummy = view.get<bool>("enabled"), std::runtime_error);
+	EXPECT_THROW([[maybe_unused]] auto& dummy = view.get<1>(), std::runtime_error);
+	EXPECT_THROW([[maybe_unused]] auto& dummy = view.get<double>("myInt"), std::invalid_argument);
+	EXPECT_THROW([[maybe_unused]] auto& dummy = view.get<int>(3), std::out_of_range);
+
+	defaults.set("enabled", false);
+	EXPECT_EQ(view.submit([](int a, bool b, const std::string& c) { return c + std::to_string(a) + std::to_string(b); }),
+						"Homer Simpson10");
+}
+
+TEST_F(ParameterMapTestSuite, FillMissingFromKeepsStoredValues) {
+	ParameterMap<int, bool, const std::string&> global{"myInt", "enabled", "name"};
+	global.set("myInt", 1);
+	global.set("enabled", false);
+	StaticParameterMap<TestParameterNames, int, bool, const std::string&> asset;
+	asset.set("enabled", true);
+
+	asset.fill_missing_from(global);
+	EXPECT_EQ(asset.get<int>("myInt"), 1);
+	EXPECT_TRUE(asset.get<bool>("enabled"));
+	EXPECT_FALSE(asset.is_set("name"));
+	EXPECT_EQ(global.get<int>("myInt"), 1);
+}
+
+TEST_F(ParameterMapTestSuite, OverwriteWithReplacesStoredValues) {
+	ParameterMap<int, bool, const std::string&> map{"myInt", "enabled", "name"};
+	map.set("myInt", 1);
+	map.set("name", "Marge Simpson");
+	ParameterMap<int, bool, const std::string&> project{"myInt", "enabled", "name"};
+	project.set("name", "Homer Simpson");
+	project.set("enabled", true);
+
+	map.overwrite_with(project);
+	EXPECT_EQ(map.get<int>("myInt"), 1);
+	EXPECT_TRUE(map.get<bool>("enabled"));
+	EXPECT_EQ(map.get<std::string>("name"), "Homer Simpson");
+	map.merge_from(map);
+	EXPECT_EQ(map.get<std::string>("name"), "Homer Simpson");
+}
+
+TEST_F(ParameterMapTestSuite, MergeFromCopiesOnlyTakenOverValuesAndMovesFromRvalues) {
+	int copies = 0;
+	ParameterMap<CopyCounter, CopyCounter> map{"a", "b"};
+	map.set("a", CopyCounter{&copies, "map"});
+	ParameterMap<CopyCounter, CopyCounter> other{"a", "b"};
+	other.set("a", CopyCounter{&copies, "other"});
+	other.set("b", CopyCounter{&copies, "other"});
+
+	map.merge_from<MergePolicy::keep_existing>(other);
+	EXPECT_EQ(copies, 1);
+	EXPECT_EQ(map.get<CopyCounter>("a").payload, "map");
+	EXPECT_EQ(map.get<CopyCounter>("b").payload, "other");
+
+	map.merge_from<MergePolicy::overwrite>(std::move(other));
+	EXPECT_EQ(copies, 1);
+	EXPECT_EQ(map.get<CopyCounter>("a").payload, "other");
+}
+
+TEST_F(ParameterMapTestSuite, BorrowedParametersReferToTheCallersValue) {
+	const std::string document = "Homer Simpson";
+	ParameterMap<int, Borrowed<const std::string>> map{"myInt", "name"};
+	map.set("myInt", 3);
+	map.set("name", document);
+
+	EXPECT_EQ(&map.get<std::string>("name"), &document);
+	EXPECT_EQ(&map.get<1>(), &document);
+	EXPECT_EQ(&*map.try_get<std::string>(1), &document);
+	const std::string* passed = nullptr;
+	map.submit([&](int, const std::string& name) { passed = &name; });
+	EXPECT_EQ(passed, &document);
+	EXPECT_LT(sizeof(qbouts::detail::ParameterStorage<Borrowed<const std::string>>),
+						sizeof(qbouts::detail::ParameterStorage<std::string>));
+
+	const std::string other = "Marge Simpson";
+	map.set(1, other);
+	EXPECT_EQ(map.get<1>(), "Marge Simpson");
+}
+
+TEST_F(ParameterMapTestSuite, BorrowedParametersCannotBeSetFromTemporaries) {
+	ParameterMap<int, Borrowed<const std::string>> map{"myInt", "name"};
+	EXPECT_THROW(map.set("name", std::string("Homer Simpson")), std::invalid_argument);
+	EXPECT_THROW(map.set("name", "Homer Simpson"), std::invalid_argument);
+	EXPECT_FALSE(map.try_set("name", 3));
+	static_assert(!std::is_constructible_v<Borrowed<const std::string>, std::string>);
+	static_assert(!std::is_constructible_v<Borrowed<const std::string>, const char*>);
+}
+
 enum class GetMemberType { BY_NAME, BY_RT_INDEX, BY_CT_INDEX };
 enum class SetMemberType { BY_NAME, BY_RT_INDEX, BY_CT_INDEX };
 
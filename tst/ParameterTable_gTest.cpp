@@ -0,0 +1,142 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ParameterTable.h"
+
+namespace {
+using qbouts::ParameterTable;
+
+template <typename TABLE, typename ITERATOR, typename = void>
+struct can_fill : std::false_type {};
+template <typename TABLE, typename ITERATOR>
+struct can_fill<TABLE,
+								ITERATOR,
+								std::void_t<decltype(std::declval<TABLE&>().template fill<1>(
+										0, std::declval<ITERATOR>(), std::declval<ITERATOR>()))>> : std::true_type {};
+
+class ParameterTableTestSuite : public ::testing::Test {
+protected:
+	ParameterTable<const std::string&, double, bool> m_table{"path", "size_percent", "flip"};
+};
+
+TEST_F(ParameterTableTestSuite, NewTableHasNoRows) {
+	EXPECT_EQ(m_table.rows(), 0);
+	EXPECT_EQ(m_table.size(), 3);
+	EXPECT_THROW(m_table.set(0, "flip", true), std::out_of_range);
+}
+
+TEST_F(ParameterTableTestSuite, ParametersCanBeSetAndRetrievedPerRow) {
+	m_table.resize(2);
+	m_table.set(0, "path", "tree.png");
+	m_table.set(1, "path", "car.png");
+	m_table.set(1, 1, 56.5);
+	m_table.set<2>(0, true);
+
+	EXPECT_EQ(m_table.get<std::string>(0, "path"), "tree.png");
+	EXPECT_EQ(m_table.get<std::string>(1, "path"), "car.png");
+	EXPECT_EQ(m_table.get<1>(1), 56.5);
+	EXPECT_TRUE(m_table.get<bool>(0, "flip"));
+	EXPECT_TRUE(m_table.is_set(1, "size_percent"));
+	EXPECT_FALSE(m_table.is_set(0, "size_percent"));
+	EXPECT_FALSE(m_table.is_set<2>(1));
+}
+
+TEST_F(ParameterTableTestSuite, InvalidRowsNamesAndTypesThrow) {
+	m_table.resize(1);
+	EXPECT_THROW(m_table.set(1, "path", "tree.png"), std::out_of_range);
+	EXPECT_THROW(m_table.set(0, "not_path", "tree.png"), std::invalid_argument);
+	EXPECT_THROW(m_table.set(0, "size_percent", "tree.png"), std::invalid_argument);
+	EXPECT_THROW(m_table.set(0, 3, 1.0), std::out_of_range);
+	EXPECT_THROW([[maybe_unused]] auto& dummy = m_table.get<double>(0, "size_percent"), std::runtime_error);
+	EXPECT_THROW([[maybe_unused]] auto& dummy = m_table.get<int>(0, "size_percent"), std::invalid_argument);
+}
+
+TEST_F(ParameterTableTestSuite, ColumnsCanBeFilledInBulk) {
+	m_table.resize(100);
+	std::vector<double> sizes(80);
+	std::iota(sizes.begin(), sizes.end(), 0.0);
+	m_table.fill<1>(10, sizes.begin(), sizes.end());
+	std::vector<std::string> paths{"a.png", "b.png"};
+	m_table.fill("path", 98, paths.begin(), paths.end());
+
+	EXPECT_FALSE(m_table.is_set<1>(9));
+	EXPECT_EQ(m_table.get<1>(10), 0.0);
+	EXPECT_EQ(m_table.get<1>(89), 79.0);
+	EXPECT_FALSE(m_table.is_set<1>(90));
+	EXPECT_EQ(m_table.get<0>(99), "b.png");
+	EXPECT_THROW(m_table.fill<1>(30, sizes.begin(), sizes.end()), std::out_of_range);
+
+	// Single pass ranges can not be checked against the table size before storing them.
+	static_assert(can_fill<decltype(m_table), std::vector<double>::iterator>::value);
+	static_assert(!can_fill<decltype(m_table), std::istream_iterator<double>>::value);
+}
+
+TEST_F(ParameterTableTestSuite, SubmitAllCallsFunctionForEveryCompleteRowInOrder) {
+	for (int i = 0; i < 130; ++i) {
+		const auto row = m_table.add_row();
+		m_table.set(row, "path", std::to_string(i));
+		m_table.set(row, "flip", i % 2 == 0);
+		if (i % 3 != 0) {
+			m_table.set(row, "size_percent", double(i));
+		}
+	}
+	auto results = m_table.submit_all([](const std::string& path, double size, bool flip) {
+		return path + ":" + std::to_string(int(size)) + (flip ? "f" : "");
+	});
+
+	std::vector<std::string> expected;
+	for (int i = 0; i < 130; ++i) {
+		if (i % 3 != 0) {
+			expected.push_back(std::to_string(i) + ":" + std::to_string(i) + (i % 2 == 0 ? "f" : ""));
+		}
+	}
+	EXPECT_EQ(results, expected);
+
+	size_t n_calls = 0;
+	m_table.submit_all([&](const std::string&, double, bool) { ++n_calls; });
+	EXPECT_EQ(n_calls, expected.size());
+	EXPECT_EQ(m_table.submit(1, [](const std::string& path, double, bool) { return path; }), "1");
+	EXPECT_THROW(m_table.submit(0, [](const std::string&, double, bool) {}), std::runtime_error);
+}
+
+TEST_F(ParameterTableTestSuite, ResizingKeepsValuesAndClearDestroysThem) {
+	auto value = std::make_shared<int>(3);
+	ParameterTable<std::shared_ptr<int>, int> table{"ptr", "myInt"};
+	table.resize(3);
+	table.set(0, "ptr", value);
+	table.set(2, "ptr", value);
+	table.set(2, "myInt", 4);
+	EXPECT_EQ(value.use_count(), 3);
+
+	table.resize(1000);
+	EXPECT_EQ(value.use_count(), 3);
+	EXPECT_EQ(table.get<int>(2, "myInt"), 4);
+
+	auto copy = table;
+	EXPECT_EQ(value.use_count(), 5);
+	EXPECT_EQ(copy.get<1>(2), 4);
+
+	table.resize(1);
+	EXPECT_EQ(value.use_count(), 4);
+	table.resize(3);
+	EXPECT_FALSE(table.is_set<0>(2));
+	EXPECT_FALSE(table.is_set<1>(2));
+
+	table.clear();
+	copy.clear();
+	EXPECT_EQ(value.use_count(), 1);
+}
+}  // namespace
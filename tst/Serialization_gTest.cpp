@@ -0,0 +1,130 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ParameterMap.h"
+#include "Serialization.h"
+
+namespace {
+using qbouts::deserialize;
+using qbouts::MappedFile;
+using qbouts::ParameterError;
+using qbouts::ParameterMap;
+using qbouts::serialize;
+using qbouts::SerializedMapView;
+using qbouts::SnapshotReader;
+
+struct Color {
+	std::uint8_t r, g, b;
+};
+
+using TextureParams = ParameterMap<const std::string &, double, bool, Color, std::string_view>;
+
+class SerializationTestSuite : public ::testing::Test {
+protected:
+	SerializationTestSuite() {
+		m_params.set("path", "car.png");
+		m_params.set("size_percent", 56.5);
+		m_params.set("flip", true);
+		m_params.set("tint", Color{1, 2, 3});
+	}
+
+	TextureParams m_params{"path", "size_percent", "flip", "tint", "label"};
+};
+
+TEST_F(SerializationTestSuite, DeserializedMapHoldsTheSameValues) {
+	const std::string record = serialize(m_params);
+	EXPECT_EQ(record.size() % 16, 0);
+
+	TextureParams copy{"path", "size_percent", "flip", "tint", "label"};
+	copy.set("label", std::string_view("stale"));
+	const auto record_size = deserialize(record, copy);
+	ASSERT_TRUE(record_size);
+	EXPECT_EQ(*record_size, record.size());
+	EXPECT_EQ(copy.get<std::string>("path"), "car.png");
+	EXPECT_EQ(copy.get<double>("size_percent"), 56.5);
+	EXPECT_TRUE(copy.get<bool>("flip"));
+	EXPECT_EQ(copy.get<Color>("tint").b, 3);
+	EXPECT_FALSE(copy.is_set("label"));
+
+	copy.set("label", std::string_view("car"));
+	const std::string with_view = serialize(copy);
+	ASSERT_TRUE(deserialize(with_view, m_params));
+	EXPECT_EQ(m_params.get<std::string_view>("label"), "car");
+	EXPECT_GE(m_params.get<std::string_view>("label").data(), with_view.data());
+	EXPECT_LT(m_params.get<std::string_view>("label").data(), with_view.data() + with_view.size());
+}
+
+TEST_F(SerializationTestSuite, FingerprintsDependOnNamesAndTypes) {
+	const TextureParams same{"path", "size_percent", "flip", "tint", "label"};
+	const TextureParams renamed{"file", "size_percent", "flip", "tint", "label"};
+	const ParameterMap<const std::string &, float, bool, Color, std::string_view> retyped{
+			"path", "size_percent", "flip", "tint", "label"};
+	EXPECT_EQ(m_params.schema_fingerprint(), same.schema_fingerprint());
+	EXPECT_NE(m_params.schema_fingerprint(), renamed.schema_fingerprint());
+	EXPECT_NE(m_params.schema_fingerprint(), retyped.schema_fingerprint());
+
+	TextureParams other_names{"file", "size_percent", "flip", "tint", "label"};
+	EXPECT_EQ(deserialize(serialize(m_params), other_names).error(), ParameterError::incompatible_type);
+	EXPECT_FALSE(other_names.is_set("size_percent"));
+}
+
+TEST_F(SerializationTestSuite, TruncatedOrCorruptRecordsAreRejected) {
+	const std::string record = serialize(m_params);
+	TextureParams copy{"path", "size_percent", "flip", "tint", "label"};
+	for (size_t size : {size_t{0}, size_t{8}, size_t{20}, record.size() - 16}) {
+		EXPECT_EQ(deserialize(std::string_view(record).substr(0, size), copy).error(), ParameterError::malformed_input);
+	}
+	std::string corrupt = record;
+	corrupt[24] = '\x7f';  // the length of "car.png"
+	EXPECT_EQ(deserialize(corrupt, copy).error(), ParameterError::malformed_input);
+	EXPECT_FALSE(copy.is_set("path"));
+}
+
+TEST_F(SerializationTestSuite, SnapshotsAreReadInPlaceFromMappedFiles) {
+	std::string snapshot;
+	for (int i = 0; i < 100; ++i) {
+		m_params.set("size_percent", static_cast<double>(i));
+		m_params.set("flip", i % 2 == 0);
+		serialize(m_params, snapshot);
+	}
+	const std::string path = ::testing::TempDir() + "Serialization_gTest.snapshot";
+	std::ofstream(path, std::ios::binary).write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+
+	{
+		const MappedFile file(path);
+		ASSERT_EQ(file.data(), snapshot);
+		SnapshotReader<TextureParams> reader(file.data(), m_params.schema_fingerprint());
+		SerializedMapView<TextureParams> view;
+		int n_records = 0;
+		for (auto has_next = reader.next(view); has_next.value(); has_next = reader.next(view), ++n_records) {
+			EXPECT_EQ(view.get<0>(), "car.png");
+			EXPECT_EQ(view.get<1>(), static_cast<double>(n_records));
+			EXPECT_EQ(view.get<2>(), n_records % 2 == 0);
+			EXPECT_GE(static_cast<const void *>(&view.get<1>()), file.data().data());
+			EXPECT_FALSE(view.is_set<4>());
+			EXPECT_THROW((void)view.get<4>(), std::runtime_error);
+		}
+		EXPECT_EQ(n_records, 100);
+
+		TextureParams copy{"path", "size_percent", "flip", "tint", "label"};
+		view.copy_to(copy);
+		EXPECT_EQ(copy.get<double>("size_percent"), 99.0);
+
+		SnapshotReader<TextureParams> misaligned(file.data().substr(1), m_params.schema_fingerprint());
+		EXPECT_EQ(misaligned.next(view).error(), ParameterError::malformed_input);
+	}
+	std::remove(path.c_str());
+	EXPECT_THROW(MappedFile{path}, std::system_error);
+}
+}  // namespace
@@ -0,0 +1,114 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ParameterMap.h"
+#include "SubmissionQueue.h"
+
+namespace {
+using qbouts::ParameterMap;
+using qbouts::SubmissionQueue;
+using qbouts::SubmissionQueueOptions;
+
+using TextureParams = ParameterMap<std::string, int>;
+using TextureEntry = std::tuple<std::string, int>;
+
+TextureParams texture_params(const std::string& path, int mip_levels) {
+	TextureParams params{"path", "mip_levels"};
+	params.set("path", path);
+	params.set("mip_levels", mip_levels);
+	return params;
+}
+
+class SubmissionQueueTestSuite : public ::testing::Test {
+protected:
+	auto record_batches() {
+		return [this](std::vector<TextureEntry>& batch) { m_batches.push_back(batch); };
+	}
+
+	std::vector<std::vector<TextureEntry>> m_batches;
+};
+
+TEST_F(SubmissionQueueTestSuite, EntriesAreDrainedInBatches) {
+	SubmissionQueue<TextureParams, decltype(record_batches())> queue{record_batches(), SubmissionQueueOptions{2}};
+	EXPECT_TRUE(queue.push(texture_params("brick", 1)));
+	EXPECT_EQ(queue.size(), 1u);
+	EXPECT_TRUE(m_batches.empty());
+	EXPECT_TRUE(queue.push(texture_params("brick", 1)));
+	EXPECT_TRUE(queue.empty());
+	EXPECT_TRUE(queue.push(texture_params("grass", 4)));
+	EXPECT_EQ(queue.flush(), 1u);
+	EXPECT_EQ(queue.flush(), 0u);
+
+	const std::vector<std::vector<TextureEntry>> expected{{{"brick", 1}, {"brick", 1}}, {{"grass", 4}}};
+	EXPECT_EQ(m_batches, expected);
+}
+
+TEST_F(SubmissionQueueTestSuite, DuplicatesArePendingOnceWhenCoalescing) {
+	SubmissionQueue<TextureParams, decltype(record_batches()), true> queue{record_batches(), SubmissionQueueOptions{0}};
+	EXPECT_TRUE(queue.push(texture_params("brick", 1)));
+	EXPECT_TRUE(queue.push(texture_params("grass", 4)));
+	EXPECT_FALSE(queue.push(texture_params("brick", 1)));
+	EXPECT_TRUE(queue.push(texture_params("brick", 2)));
+	EXPECT_EQ(queue.flush(), 3u);
+	EXPECT_TRUE(queue.push(texture_params("brick", 1)));
+	EXPECT_EQ(queue.flush(), 1u);
+
+	const std::vector<std::vector<TextureEntry>> expected{{{"brick", 1}, {"grass", 4}, {"brick", 2}}, {{"brick", 1}}};
+	EXPECT_EQ(m_batches, expected);
+}
+
+TEST_F(SubmissionQueueTestSuite, ValuesAreMovedIntoTheQueue) {
+	using BufferParams = ParameterMap<std::unique_ptr<int>>;
+	int sum = 0;
+	auto drain = [&](std::vector<std::tuple<std::unique_ptr<int>>>& batch) {
+		for (auto& [buffer] : batch) {
+			sum += *buffer;
+		}
+	};
+	SubmissionQueue<BufferParams, decltype(drain)> queue{drain};
+
+	BufferParams params{"buffer"};
+	EXPECT_THROW(queue.push(std::move(params)), std::runtime_error);
+	for (int i = 1; i <= 3; ++i) {
+		params.set("buffer", std::make_unique<int>(i));
+		queue.push(std::move(params));
+		EXPECT_FALSE(params.is_set<0>());
+	}
+	EXPECT_EQ(queue.flush(), 3u);
+	EXPECT_EQ(sum, 6);
+}
+
+TEST_F(SubmissionQueueTestSuite, CoalescingRequiresHashableValues) {
+	// SubmissionQueue<ParameterMap<std::vector<int>>, decltype(ignore), true> fails to compile.
+	auto ignore = [](std::vector<std::tuple<std::vector<int>>>&) {};
+	using MeshQueue = SubmissionQueue<ParameterMap<std::vector<int>>, decltype(ignore)>;
+	static_assert(!qbouts::detail::is_tuple_coalescable<MeshQueue::value_type>::value);
+	static_assert(qbouts::detail::is_tuple_coalescable<std::tuple<std::string, int>>::value);
+	MeshQueue queue{ignore};
+	ParameterMap<std::vector<int>> mesh{"vertices"};
+	mesh.set("vertices", std::vector<int>{1, 2, 3});
+	EXPECT_TRUE(queue.push(ParameterMap<std::vector<int>>(mesh)));
+	EXPECT_TRUE(queue.push(std::move(mesh)));
+	EXPECT_EQ(queue.flush(), 2u);
+}
+
+TEST_F(SubmissionQueueTestSuite, BatchesAreDiscardedWhenTheFunctionThrows) {
+	auto fail = [](std::vector<TextureEntry>&) { throw std::logic_error("factory failed"); };
+	SubmissionQueue<TextureParams, decltype(fail), true> queue{fail, SubmissionQueueOptions{0}};
+	queue.push(texture_params("brick", 1));
+	EXPECT_THROW(queue.flush(), std::logic_error);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_TRUE(queue.push(texture_params("brick", 1)));
+	EXPECT_THROW(queue.flush(), std::logic_error);
+}
+}  // namespace
@@ -0,0 +1,85 @@
+/***************************************************************
+ * Author: Quirijn Bouts (www.qbouts.com | github.com/qbouts)  *
+ * LICENSE: MIT                                                *
+ ***************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ParameterMap.h"
+#include "XmlBinder.h"
+
+namespace {
+using qbouts::bind_xml;
+using qbouts::ParameterMap;
+using qbouts::UnknownParameterPolicy;
+using qbouts::XmlElement;
+using qbouts::XmlElementReader;
+
+class XmlBinderTestSuite : public ::testing::Test {
+protected:
+	ParameterMap<const std::string&, double, bool> m_params{"path", "size_percent", "flip"};
+};
+
+TEST_F(XmlBinderTestSuite, ElementsAreBoundToParametersOfTheirType) {
+	const std::string_view xml = R"(
+		<?xml version="1.0"?>
+		<!-- a car -->
+		<path type="string">car.png</path>
+		<size_percent type="double"> 56.5 </size_percent>
+		<flip type="bool">true</flip>)";
+	EXPECT_EQ(bind_xml(xml, m_params), 3);
+	EXPECT_EQ(m_params.get<std::string>("path"), "car.png");
+	EXPECT_EQ(m_params.get<double>("size_percent"), 56.5);
+	EXPECT_TRUE(m_params.get<bool>("flip"));
+}
+
+TEST_F(XmlBinderTestSuite, NestedElementsCanBeReadOneByOne) {
+	const std::string_view xml = R"(
+		<tree><path type="string">tree.png</path></tree>
+		<car>
+			<path type="string">car.png</path>
+			<size_percent type="double">56.5</size_percent>
+			<extra><path>not bound</path></extra>
+		</car>
+		<empty/>)";
+	std::vector<std::string> names;
+	XmlElementReader reader(xml);
+	for (XmlElement element; reader.next(element);) {
+		names.emplace_back(element.name);
+		if (element.name == "car") {
+			EXPECT_EQ(bind_xml(element.content, m_params), 2);
+		}
+	}
+	EXPECT_EQ(names, (std::vector<std::string>{"tree", "car", "empty"}));
+	EXPECT_EQ(m_params.get<std::string>("path"), "car.png");
+	EXPECT_FALSE(m_params.is_set("flip"));
+}
+
+TEST_F(XmlBinderTestSuite, EntitiesAndCdataAreDecodedForStrings) {
+	bind_xml(R"(<path>a &lt;b&gt; &amp; &#65;&#x42;<![CDATA[<c>]]></path>)", m_params);
+	EXPECT_EQ(m_params.get<std::string>("path"), "a <b> & AB<c>");
+
+	const std::string_view xml = "<name>Homer</name><age>38</age>";
+	ParameterMap<std::string_view, int> view_params{"name", "age"};
+	bind_xml(xml, view_params);
+	EXPECT_EQ(view_params.get<std::string_view>("name").data(), xml.data() + 6);
+	EXPECT_EQ(view_params.get<int>("age"), 38);
+	EXPECT_THROW(bind_xml("<name>&amp;</name>", view_params), std::invalid_argument);
+}
+
+TEST_F(XmlBinderTestSuite, InvalidValuesAndMalformedXmlThrow) {
+	EXPECT_THROW(bind_xml("<size_percent>large</size_percent>", m_params), std::invalid_argument);
+	EXPECT_THROW(bind_xml("<flip>yes</flip>", m_params), std::invalid_argument);
+	EXPECT_THROW(bind_xml("<flip>true</flop>", m_params), std::runtime_error);
+	EXPECT_THROW(bind_xml("<flip>true", m_params), std::runtime_error);
+	EXPECT_THROW(bind_xml("<path>&unknown;</path>", m_params), std::runtime_error);
+
+	EXPECT_EQ(bind_xml("<color>red</color>", m_params), 0);
+	EXPECT_THROW(bind_xml("<color>red</color>", m_params, UnknownParameterPolicy::reject), std::invalid_argument);
+}
+}  // namespace